@@ -0,0 +1,280 @@
+/* Start Header -------------------------------------------------------
+File Name: Batch.cpp
+Purpose: Headless runner for experiment specification files.
+		 Batch.exe spec.json [more.json ...] [--threads n] [--cache dir]
+		           [--no-cache] [--stats file] [--trace file] [--histograms file]
+		           [--dry-run]
+		 Batch.exe --self-test
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <chrono>
+
+#include "Experiment.hpp"
+#include "ThreadPool.hpp"
+#include "ResultCache.hpp"
+#include "EngineStats.hpp"
+#include "LoopHistograms.hpp"
+#include "Trace.hpp"
+#include "SelfTest.hpp"
+
+static void Usage()
+{
+	printf("Batch.exe spec.json [more.json ...] [--threads n] [--cache dir] [--no-cache] [--stats file] [--trace file] [--histograms file] [--dry-run]\n");
+	printf("Batch.exe --self-test\n");
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> files;
+	std::string stats, trace, histograms;
+	std::string cacheDirectory = "cache";
+	int threads = 0;
+	bool dryRun = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--threads" && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (arg == "--cache" && i + 1 < argc)
+			cacheDirectory = argv[++i];
+		else if (arg == "--no-cache")
+			cacheDirectory.clear();
+		else if (arg == "--stats" && i + 1 < argc)
+			stats = argv[++i];
+		else if (arg == "--trace" && i + 1 < argc)
+			trace = argv[++i];
+		else if (arg == "--histograms" && i + 1 < argc)
+			histograms = argv[++i];
+		else if (arg == "--dry-run")
+			dryRun = true;
+		else if (arg == "--self-test")
+			return RunSelfTests() ? 1 : 0;
+		else if (arg == "--help")
+		{
+			Usage();
+			return 0;
+		}
+		else if (arg.compare(0, 2, "--") == 0)
+		{
+			fprintf(stderr, "Unknown option : %s\n", arg.c_str());
+			return 2;
+		}
+		else
+			files.push_back(arg);
+	}
+	if (files.empty())
+	{
+		Usage();
+		return 2;
+	}
+
+	//read every file first so a typo in the last one fails before any work
+	std::vector<ExperimentSpec> specs;
+	std::vector<ExperimentGrid> grids;
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		std::string error;
+		if (!LoadExperimentSpecs(files[i], specs, grids, error))
+		{
+			fprintf(stderr, "Error : %s\n", error.c_str());
+			return 2;
+		}
+	}
+
+	std::vector<std::string> outputs;
+	std::vector<int> specGrid(specs.size(), -1);
+	int points = 0;
+	for (size_t s = 0; s < specs.size(); ++s)
+	{
+		points += (int)specs[s].horizons.size();
+		outputs.insert(outputs.end(), specs[s].outputs.begin(), specs[s].outputs.end());
+		if (!specs[s].tree_output.empty())
+			outputs.push_back(specs[s].tree_output);
+		if (!specs[s].msd_output.empty())
+			outputs.push_back(specs[s].msd_output);
+		if (!specs[s].return_time_output.empty())
+			outputs.push_back(specs[s].return_time_output);
+	}
+	for (size_t g = 0; g < grids.size(); ++g)
+	{
+		outputs.insert(outputs.end(), grids[g].outputs.begin(), grids[g].outputs.end());
+		for (size_t c = 0; c < grids[g].cells.size(); ++c)
+			specGrid[grids[g].cells[c]] = (int)g;
+	}
+	std::set<std::string> unique_outputs;
+	for (size_t o = 0; o < outputs.size(); ++o)
+	{
+		if (!unique_outputs.insert(outputs[o]).second)
+		{
+			fprintf(stderr, "Error : %s is the output of two experiments\n", outputs[o].c_str());
+			return 2;
+		}
+	}
+
+	if (dryRun)
+	{
+		for (size_t g = 0; g < grids.size(); ++g)
+			printf("grid %s: %i cells\n", grids[g].name.c_str(), (int)grids[g].cells.size());
+		for (size_t s = 0; s < specs.size(); ++s)
+		{
+			const ExperimentSpec& spec = specs[s];
+			printf("%-24s %-12s box=%s horizons=%i..%i (%i) trials=%i", spec.name.c_str(), WalkKindNames[spec.walk],
+				DescribeBox(MakeWalk(spec)).c_str(), spec.horizons.front(), spec.horizons.back(), (int)spec.horizons.size(), spec.trials);
+			if (spec.target_error > 0.0)
+				printf(" target_error=%g max_trials=%i", spec.target_error, spec.max_trials);
+			if (spec.censored)
+				printf(" censored");
+			if (spec.walk == WALK_LEVY)
+				printf(" alpha=%g", spec.alpha);
+			if (MakeWalk(spec).biased)
+				printf(" biased");
+			if (!spec.graph.empty())
+				printf(" graph=%s reorder=%s", spec.graph.c_str(), spec.reorder.c_str());
+			printf(" seed=%llu\n", spec.seed);
+		}
+		return 0;
+	}
+
+	RegisterStatsThread("batch");
+	TRACE_THREAD("batch");
+
+	//before anything runs, so a bad edge list does not cost a whole batch
+	std::string graphError;
+	if (!LoadExperimentGraphs(specs, graphError))
+	{
+		fprintf(stderr, "Error : %s\n", graphError.c_str());
+		return 2;
+	}
+
+	//the histograms fill as loops are erased, which a cached chunk skips
+	if (!histograms.empty())
+	{
+		for (size_t s = 0; s < specs.size(); ++s)
+			specs[s].uncached = specs[s].walk == WALK_LOOP_ERASED || specs[s].walk == WALK_SPANNING_TREE;
+	}
+
+	ResultCache cache;
+	if (!cacheDirectory.empty() && !cache.Open(cacheDirectory))
+		fprintf(stderr, "Cannot use %s as cache, running without it\n", cacheDirectory.c_str());
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<std::vector<ExperimentPoint>> results;
+	std::vector<ReturnTimes> returnTimes;
+	int failed = 0;
+
+	//grid cells stream into their grid as they finish
+	std::vector<GridWriter> writers(grids.size());
+	for (size_t g = 0; g < grids.size(); ++g)
+	{
+		if (!writers[g].Open(grids[g], start))
+			++failed;
+	}
+	PointCallback done = [&](int spec, int, const ExperimentPoint& point)
+	{
+		if (specGrid[spec] >= 0)
+			writers[specGrid[spec]].Append(specs[spec], point);
+	};
+
+	int unique;
+	{
+		ThreadPool pool(threads);
+		printf("%i experiments, %i data points on %i threads\n", (int)specs.size(), points, pool.Size());
+		unique = RunExperiments(specs, pool, results, true, done, &cache, &returnTimes);
+
+		//the single long walks spread their axes over the pool
+		for (size_t s = 0; s < specs.size(); ++s)
+		{
+			if (specs[s].msd_output.empty())
+				continue;
+			if (WriteWalkMsd(specs[s], &pool))
+				printf("Wrote %s\n", specs[s].msd_output.c_str());
+			else
+			{
+				fprintf(stderr, "Error : cannot write %s\n", specs[s].msd_output.c_str());
+				++failed;
+			}
+		}
+	}
+	for (size_t g = 0; g < grids.size(); ++g)
+		writers[g].Close();
+
+	for (size_t s = 0; s < specs.size(); ++s)
+	{
+		if (specGrid[s] < 0 && !WriteExperiment(specs[s], results[s], start))
+			++failed;
+		if (!specs[s].return_time_output.empty())
+		{
+			if (WriteReturnTimes(specs[s], returnTimes[s], start))
+				printf("Wrote %s\n", specs[s].return_time_output.c_str());
+			else
+			{
+				fprintf(stderr, "Error : cannot write %s\n", specs[s].return_time_output.c_str());
+				++failed;
+			}
+		}
+		if (!specs[s].tree_output.empty())
+		{
+			if (WriteSpanningTree(specs[s]))
+				printf("Wrote %s\n", specs[s].tree_output.c_str());
+			else
+			{
+				fprintf(stderr, "Error : cannot write %s\n", specs[s].tree_output.c_str());
+				++failed;
+			}
+		}
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%i distinct data points (%i shared) in %.1f s\n", unique, points - unique, seconds);
+	if (cache.IsOpen())
+		printf("%i trial chunks from the cache, %i computed\n", cache.hits.load(), cache.misses.load());
+
+	if (!stats.empty())
+	{
+		if (WriteStatsJson(stats.c_str()))
+			printf("Wrote %s\n", stats.c_str());
+		else
+			fprintf(stderr, "Error : cannot write %s\n", stats.c_str());
+	}
+
+	//covers every loop-erased walk and spanning tree of this run
+	if (!histograms.empty())
+	{
+		RunMetadata meta;
+		meta.experiment = "loop_histograms";
+		meta.lattice = CUBIC_LATTICE;
+		meta.seed = 0;
+		meta.trials = 0;
+		for (size_t s = 0; s < specs.size(); ++s)
+		{
+			if (specs[s].walk == WALK_LOOP_ERASED)
+				meta.extra.push_back(std::make_pair(specs[s].name, DescribeBox(MakeWalk(specs[s]))));
+		}
+		if (WriteLoopHistograms(histograms, meta))
+			printf("Wrote %s\n", histograms.c_str());
+		else
+			fprintf(stderr, "Error : cannot write %s\n", histograms.c_str());
+	}
+
+	//only has zones to write when built with RW_TRACE
+	if (!trace.empty())
+	{
+		if (WriteChromeTrace(trace.c_str()))
+			printf("Wrote %s\n", trace.c_str());
+		else
+			fprintf(stderr, "Error : cannot write %s\n", trace.c_str());
+	}
+	return failed ? 1 : 0;
+}
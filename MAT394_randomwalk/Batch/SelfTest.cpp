@@ -0,0 +1,261 @@
+/* Start Header -------------------------------------------------------
+File Name: SelfTest.cpp
+Purpose: Statistical checks of the walk engine for Batch.exe --self-test
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include <glm/glm.hpp>
+
+#include "SelfTest.hpp"
+#include "RandomWalk.hpp"
+#include "LaplacianWalk.hpp"
+#include "ContinuousWalk.hpp"
+#include "GraphWalk.hpp"
+#include "Experiment.hpp"
+#include "ThreadPool.hpp"
+
+//chunks of every estimate; the error comes from their spread
+#define SELF_TEST_CHUNKS 20
+
+#define PI 3.14159265358979323846
+
+struct Estimate {
+	double mean;
+	double error;
+};
+
+static int checks = 0;
+static int failed = 0;
+
+// Mean and standard error of the chunk means, chunk c seeded from c.
+static Estimate Chunks(unsigned long long check, const std::function<double(unsigned long long)>& chunk)
+{
+	double sum = 0.0, square = 0.0;
+	for (int c = 0; c < SELF_TEST_CHUNKS; ++c)
+	{
+		double value = chunk(MixSeed(check, c));
+		sum += value;
+		square += value * value;
+	}
+	double mean = sum / SELF_TEST_CHUNKS;
+	double spread = std::max(0.0, square / SELF_TEST_CHUNKS - mean * mean);
+	return { mean, sqrt(spread / (SELF_TEST_CHUNKS - 1)) };
+}
+
+static Estimate Exact(double value)
+{
+	return { value, 0.0 };
+}
+
+static void Check(const char* name, const Estimate& measured, const Estimate& expected)
+{
+	double error = sqrt(measured.error * measured.error + expected.error * expected.error);
+	double z = error > 0.0 ? (measured.mean - expected.mean) / error : measured.mean == expected.mean ? 0.0 : HUGE_VAL;
+	bool ok = fabs(z) < SELF_TEST_Z;
+	printf("%-4s %-44s %12.6g %12.6g   z = %+.2f\n", ok ? "ok" : "FAIL", name, measured.mean, expected.mean, z);
+	++checks;
+	if (!ok)
+		++failed;
+}
+
+// Mean square end-to-end distance of walks of the given steps.
+static double SquareChunk(RandomWalk& walker, unsigned long long seed, int steps)
+{
+	walker.rng.Seed(seed);
+	double sum = 0.0;
+	for (int i = 0; i < 100; ++i)
+	{
+		walker.Reset();
+		for (int j = 0; j < steps; ++j)
+			walker.Walk();
+		glm::vec3 end = walker.points.back() - walker.startPosition;
+		sum += glm::dot(end, end);
+	}
+	return sum / 100.0;
+}
+
+static double ReturnChunk(unsigned long long seed, int steps, bool jumps)
+{
+	//uniform weights taken as a bias make the walk step one at a time
+	RandomWalk walker;
+	walker.biased = !jumps;
+	walker.rng.Seed(seed);
+	float prob;
+	ReturnTrials(walker, steps, 1000, prob);
+	return prob;
+}
+
+static double BoxChunk(unsigned long long seed, bool laplacian)
+{
+	LaplacianWalk walker;
+	walker.rng.Seed(seed);
+	float length, inner;
+	LaplacianTrials(walker, 4, 50, laplacian, length, inner);
+	return length;
+}
+
+static double GaussianChunk(unsigned long long seed, int steps)
+{
+	RandomWalk walker;
+	walker.kernel = KERNEL_GAUSSIAN;
+	Rng rng(seed);
+	float distance, log_distance;
+	ContinuousTrials(rng, walker, steps, 1000, distance, log_distance);
+	return distance;
+}
+
+// Steps with weights 1 to 6: the chi-square of the direction counts
+// against them, which has 5 degrees of freedom.
+static double WeightChiSquare(unsigned long long seed)
+{
+	double weights[6] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+	StepDistribution steps;
+	steps.Set(weights, 0.0);
+	Rng rng(seed);
+	const int draws = 21000;
+	long long counts[6] = {};
+	for (int i = 0; i < draws; ++i)
+		++counts[steps.Sample(rng, glm::vec3(0.f), STEP_FIRST)];
+	double chi = 0.0;
+	for (int d = 0; d < 6; ++d)
+	{
+		double expected = draws * weights[d] / 21.0;
+		chi += (counts[d] - expected) * (counts[d] - expected) / expected;
+	}
+	return chi;
+}
+
+static double CycleReturnChunk(const CsrGraph& cycle, unsigned long long seed, int steps)
+{
+	Rng rng(seed);
+	float hit, time;
+	GraphPassageTrials(cycle, rng, 0, 0, steps, 1000, hit, time);
+	return hit;
+}
+
+// An unbounded uniform return spec as ReadSpec would fill it in.
+static ExperimentSpec ReturnSpec(const char* name, bool censored)
+{
+	ExperimentSpec spec = ExperimentSpec();
+	spec.name = name;
+	spec.walk = WALK_RETURN;
+	spec.lattice = "cubic";
+	spec.dimension = 3;
+	spec.limit_min = glm::vec3(-200.f);
+	spec.limit_max = glm::vec3(200.f);
+	spec.horizons = { 10, 100, 1000 };
+	spec.trials = 20000;
+	spec.max_trials = spec.trials;
+	spec.seed = 12;
+	for (int d = 0; d < 6; ++d)
+		spec.weights[d] = 1.0;
+	spec.persistence = 1.0 / 6.0;
+	spec.reversal = 1.0 / 6.0;
+	spec.alpha = 1.5;
+	spec.censored = censored;
+	return spec;
+}
+
+// Runs a censored return spec and the same spec point by point through
+// RunExperiments. The last horizon uses the same chunk streams either way.
+static void CheckCensored()
+{
+	std::vector<ExperimentSpec> specs = { ReturnSpec("censored", true), ReturnSpec("separate", false) };
+	ThreadPool pool;
+	std::vector<std::vector<ExperimentPoint>> results;
+	RunExperiments(specs, pool, results, false);
+	const std::vector<ExperimentPoint>& censored = results[0];
+	const std::vector<ExperimentPoint>& separate = results[1];
+	for (size_t h = 0; h < specs[0].horizons.size(); ++h)
+	{
+		char name[64];
+		snprintf(name, sizeof(name), "return by %i steps, censored vs separate", specs[0].horizons[h]);
+		if (h + 1 < specs[0].horizons.size())
+			Check(name, { censored[h].value[0], censored[h].error }, { separate[h].value[0], separate[h].error });
+		else
+		{
+			//the same walks, up to the float rounding of the chunk means
+			Check(name, Exact(censored[h].value[0]), { separate[h].value[0], 1e-6 });
+		}
+	}
+}
+
+int RunSelfTests()
+{
+	printf("%-4s %-44s %12s %12s\n", "", "check", "measured", "expected");
+	checks = 0;
+	failed = 0;
+
+	//independent unit steps: <R^2> = n
+	Check("normal <R^2> after 1000 steps",
+		Chunks(11, [](unsigned long long seed) { RandomWalk walker; return SquareChunk(walker, seed, 1000); }),
+		Exact(1000.0));
+
+	//the cube jumps have the law of the steps they replace
+	Check("return by 1000 steps, jumps vs steps",
+		Chunks(1, [](unsigned long long seed) { return ReturnChunk(seed, 1000, true); }),
+		Chunks(2, [](unsigned long long seed) { return ReturnChunk(seed, 1000, false); }));
+
+	//the Laplacian walk with eta = 1 samples the loop-erased walk's law
+	Check("path length to radius 4, laplacian vs erased",
+		Chunks(5, [](unsigned long long seed) { return BoxChunk(seed, true); }),
+		Chunks(6, [](unsigned long long seed) { return BoxChunk(seed, false); }));
+
+	//a censored spec reads every horizon off one set of return times
+	CheckCensored();
+
+	//unit variance steps: |r| after n steps is Maxwell, mean sqrt(8n / 3pi)
+	Check("gaussian mean distance after 100 steps",
+		Chunks(7, [](unsigned long long seed) { return GaussianChunk(seed, 100); }),
+		Exact(sqrt(800.0 / (3.0 * PI))));
+
+	//a chi-square of 5 degrees of freedom has mean 5 and variance 10; the
+	//chunks give the spread
+	Check("step weights 1..6, chi-square of counts",
+		Chunks(9, WeightChiSquare), Exact(5.0));
+
+	//successive steps correlate by c = persistence - reversal, so
+	//<R^2> = n + 2 sum_k (n - k) c^k
+	const int steps = 1000;
+	const double persistence = 0.2, reversal = 0.0;
+	double c = persistence - reversal, square = steps;
+	for (int k = 1; k < steps; ++k)
+		square += 2.0 * (steps - k) * pow(c, k);
+	Check("non-backtracking <R^2> after 1000 steps",
+		Chunks(8, [=](unsigned long long seed)
+		{
+			RandomWalk walker;
+			walker.bias.SetMemory(true, persistence, reversal);
+			walker.biased = true;
+			return SquareChunk(walker, seed, steps);
+		}),
+		Exact(square));
+
+	//on a cycle too long to wrap, the walk on Z: no return in 2m steps has
+	//probability C(2m, m) / 4^m
+	CsrGraph cycle;
+	std::vector<uint32_t> ends;
+	for (uint32_t v = 0; v < 1000; ++v)
+	{
+		ends.push_back(v);
+		ends.push_back((v + 1) % 1000);
+	}
+	cycle.Build(ends);
+	double stay = exp(lgamma(101.0) - 2.0 * lgamma(51.0) - 100.0 * log(2.0));
+	Check("cycle graph return by 100 steps",
+		Chunks(10, [&cycle](unsigned long long seed) { return CycleReturnChunk(cycle, seed, 100); }),
+		Exact(1.0 - stay));
+
+	printf("%i of %i checks failed\n", failed, checks);
+	return failed;
+}
@@ -0,0 +1,23 @@
+/* Start Header -------------------------------------------------------
+File Name: SelfTest.hpp
+Purpose: Statistical checks of the walk engine for Batch.exe --self-test
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef SELFTEST_HPP
+#define SELFTEST_HPP
+
+//every check has a fixed seed, so a pass or a fail is reproducible
+#define SELF_TEST_Z 4.0
+
+// Runs every check with fixed seeds, prints one line per check and returns
+// the number that failed. A check compares two estimates, or an estimate
+// and an exact value, and fails beyond SELF_TEST_Z standard errors.
+int RunSelfTests();
+
+#endif
@@ -0,0 +1,325 @@
+/* Start Header -------------------------------------------------------
+File Name: Benchmark.cpp
+Purpose: Benchmark runner, JSON output and baseline comparison.
+		 Benchmark.exe [--out file] [--filter text] [--samples n] [--min-time sec]
+		               [--seed n] [--stats file] [--trace file] [--no-render] [--list]
+		 Benchmark.exe --compare baseline.json current.json [--threshold percent]
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+
+#include "Benchmark.hpp"
+#include "RandomWalk.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool RunCase(const BenchmarkCase& bc, const BenchmarkOptions& opt, BenchmarkResult& result)
+{
+	int reps = 1;
+	long long ops = 0;
+	double elapsed = 0.0;
+	int samples = bc.endToEnd ? opt.sweepSamples : opt.samples;
+
+	SeedRandom(opt.seed);
+
+	//find a repetition count that fills one sample
+	if (!bc.endToEnd)
+	{
+		double target = opt.minTime / samples;
+		for (;;)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			ops = bc.Run(reps);
+			elapsed = Seconds(start);
+			if (ops < 0)
+				return false;
+			if (elapsed >= target || reps >= (1 << 28))
+				break;
+
+			double grow = elapsed > 0.0 ? 1.5 * target / elapsed : 10.0;
+			grow = std::min(std::max(grow, 2.0), 100.0);
+			reps = (int)std::min(reps * grow, (double)(1 << 28));
+		}
+	}
+
+	std::vector<double> ns;
+	for (int s = 0; s < samples; ++s)
+	{
+		SeedRandom(opt.seed + s);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		ops = bc.Run(reps);
+		elapsed = Seconds(start);
+		if (ops <= 0)
+			return false;
+		ns.push_back(elapsed * 1e9 / (double)ops);
+	}
+	std::sort(ns.begin(), ns.end());
+
+	result.name = bc.name;
+	result.unit = bc.unit;
+	result.samples = samples;
+	result.reps = reps;
+	result.ops = ops;
+	result.ns_per_op = ns[ns.size() / 2];
+	result.min_ns_per_op = ns.front();
+	result.ops_per_sec = 1e9 / result.ns_per_op;
+	return true;
+}
+
+bool WriteBenchmarkJson(const std::string& path, const BenchmarkOptions& opt, const std::vector<BenchmarkResult>& results)
+{
+	FILE* file = fopen(path.c_str(), "w");
+	if (!file)
+		return false;
+
+	char date[64];
+	time_t now = time(NULL);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+	//one benchmark per line so ReadBenchmarkJson can stay line based
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"context\": { \"date\": \"%s\", \"seed\": %u, \"samples\": %i, \"min_time\": %g, \"trials\": %i },\n",
+		date, opt.seed, opt.samples, opt.minTime, TRIALS);
+	fprintf(file, "\t\"benchmarks\": [\n");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const BenchmarkResult& r = results[i];
+		fprintf(file, "\t\t{ \"name\": \"%s\", \"unit\": \"%s\", \"samples\": %i, \"reps\": %i, \"ops\": %lld, \"ns_per_op\": %.4f, \"min_ns_per_op\": %.4f, \"ops_per_sec\": %.1f }%s\n",
+			r.name.c_str(), r.unit.c_str(), r.samples, r.reps, r.ops, r.ns_per_op, r.min_ns_per_op, r.ops_per_sec,
+			i + 1 < results.size() ? "," : "");
+	}
+	fprintf(file, "\t]\n}\n");
+	fclose(file);
+	return true;
+}
+
+static bool JsonString(const std::string& line, const char* key, std::string& value)
+{
+	std::string pattern = std::string("\"") + key + "\": \"";
+	size_t pos = line.find(pattern);
+	if (pos == std::string::npos)
+		return false;
+	pos += pattern.size();
+	size_t end = line.find('"', pos);
+	if (end == std::string::npos)
+		return false;
+	value = line.substr(pos, end - pos);
+	return true;
+}
+
+static bool JsonNumber(const std::string& line, const char* key, double& value)
+{
+	std::string pattern = std::string("\"") + key + "\": ";
+	size_t pos = line.find(pattern);
+	if (pos == std::string::npos)
+		return false;
+	value = atof(line.c_str() + pos + pattern.size());
+	return true;
+}
+
+bool ReadBenchmarkJson(const std::string& path, std::vector<BenchmarkResult>& results)
+{
+	std::ifstream stream(path.c_str());
+	if (!stream.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(stream, line))
+	{
+		BenchmarkResult r;
+		double samples = 0, reps = 0, ops = 0;
+		if (!JsonString(line, "name", r.name) || !JsonNumber(line, "ns_per_op", r.ns_per_op))
+			continue;
+		JsonString(line, "unit", r.unit);
+		JsonNumber(line, "samples", samples);
+		JsonNumber(line, "reps", reps);
+		JsonNumber(line, "ops", ops);
+		JsonNumber(line, "min_ns_per_op", r.min_ns_per_op);
+		JsonNumber(line, "ops_per_sec", r.ops_per_sec);
+		r.samples = (int)samples;
+		r.reps = (int)reps;
+		r.ops = (long long)ops;
+		results.push_back(r);
+	}
+	return true;
+}
+
+int CompareBenchmarks(const std::string& baseline, const std::string& current, double threshold)
+{
+	std::vector<BenchmarkResult> base, curr;
+	if (!ReadBenchmarkJson(baseline, base))
+	{
+		fprintf(stderr, "Error : cannot open %s\n", baseline.c_str());
+		return 2;
+	}
+	if (!ReadBenchmarkJson(current, curr))
+	{
+		fprintf(stderr, "Error : cannot open %s\n", current.c_str());
+		return 2;
+	}
+
+	int regressions = 0;
+	printf("%-40s %14s %14s %9s\n", "BENCHMARK", "BASE ns/op", "CURR ns/op", "CHANGE");
+	for (size_t i = 0; i < curr.size(); ++i)
+	{
+		const BenchmarkResult* match = NULL;
+		for (size_t j = 0; j < base.size(); ++j)
+			if (base[j].name == curr[i].name)
+				match = &base[j];
+
+		if (!match)
+		{
+			printf("%-40s %14s %14.2f %9s\n", curr[i].name.c_str(), "-", curr[i].ns_per_op, "new");
+			continue;
+		}
+
+		double change = (curr[i].ns_per_op / match->ns_per_op - 1.0) * 100.0;
+		const char* flag = "";
+		if (change > threshold)
+		{
+			flag = "  REGRESSION";
+			++regressions;
+		}
+		else if (change < -threshold)
+			flag = "  improved";
+
+		printf("%-40s %14.2f %14.2f %+8.1f%%%s\n", curr[i].name.c_str(), match->ns_per_op, curr[i].ns_per_op, change, flag);
+	}
+
+	printf("\n%i regression(s) over %.1f%%\n", regressions, threshold);
+	return regressions ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions opt;
+	bool list = false;
+	std::string baseline, current;
+	double threshold = 10.0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool more = i + 1 < argc;
+
+		if (arg == "--compare" && i + 2 < argc)
+		{
+			baseline = argv[++i];
+			current = argv[++i];
+		}
+		else if (arg == "--threshold" && more)
+			threshold = atof(argv[++i]);
+		else if (arg == "--out" && more)
+			opt.out = argv[++i];
+		else if (arg == "--filter" && more)
+			opt.filter = argv[++i];
+		else if (arg == "--samples" && more)
+			opt.samples = std::max(1, atoi(argv[++i]));
+		else if (arg == "--sweep-samples" && more)
+			opt.sweepSamples = std::max(1, atoi(argv[++i]));
+		else if (arg == "--min-time" && more)
+			opt.minTime = atof(argv[++i]);
+		else if (arg == "--seed" && more)
+			opt.seed = (unsigned)strtoul(argv[++i], NULL, 10);
+		else if (arg == "--stats" && more)
+			opt.stats = argv[++i];
+		else if (arg == "--trace" && more)
+			opt.trace = argv[++i];
+		else if (arg == "--no-render")
+			opt.render = false;
+		else if (arg == "--list")
+			list = true;
+		else
+		{
+			fprintf(stderr, "Unknown option : %s\n", arg.c_str());
+			return 2;
+		}
+	}
+	if (!baseline.empty())
+		return CompareBenchmarks(baseline, current, threshold);
+
+	RegisterStatsThread("benchmark");
+	TRACE_THREAD("benchmark");
+
+	std::vector<BenchmarkCase> cases;
+	RegisterWalkBenchmarks(cases);
+	RegisterExportBenchmarks(cases);
+	if (opt.render && !RegisterRenderBenchmarks(cases))
+		fprintf(stderr, "No OpenGL context, skipping render benchmarks\n");
+
+	std::vector<BenchmarkResult> results;
+	for (size_t i = 0; i < cases.size(); ++i)
+	{
+		if (!opt.filter.empty() && cases[i].name.find(opt.filter) == std::string::npos)
+			continue;
+		if (list)
+		{
+			printf("%s\n", cases[i].name.c_str());
+			continue;
+		}
+
+		BenchmarkResult r;
+		if (!RunCase(cases[i], opt, r))
+		{
+			printf("%-40s skipped\n", cases[i].name.c_str());
+			continue;
+		}
+		printf("%-40s %14.2f ns/%-8s %14.0f %s/s\n", r.name.c_str(), r.ns_per_op, r.unit.c_str(), r.ops_per_sec, r.unit.c_str());
+		fflush(stdout);
+		results.push_back(r);
+	}
+
+	if (opt.render)
+		ShutdownRenderBenchmarks();
+
+	if (list)
+		return 0;
+
+	if (!WriteBenchmarkJson(opt.out, opt, results))
+	{
+		fprintf(stderr, "Error : cannot write %s\n", opt.out.c_str());
+		return 2;
+	}
+	printf("\nWrote %s\n", opt.out.c_str());
+
+	if (!opt.stats.empty())
+	{
+		if (!WriteStatsJson(opt.stats.c_str()))
+		{
+			fprintf(stderr, "Error : cannot write %s\n", opt.stats.c_str());
+			return 2;
+		}
+		printf("Wrote %s\n", opt.stats.c_str());
+	}
+
+	//only has zones to write when built with RW_TRACE
+	if (!opt.trace.empty())
+	{
+		if (!WriteChromeTrace(opt.trace.c_str()))
+		{
+			fprintf(stderr, "Error : cannot write %s\n", opt.trace.c_str());
+			return 2;
+		}
+		printf("Wrote %s\n", opt.trace.c_str());
+	}
+	return 0;
+}
@@ -0,0 +1,60 @@
+/* Start Header -------------------------------------------------------
+File Name: Benchmark.hpp
+Purpose: Benchmark cases, harness options and results
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+
+// Run(reps) does the measured work reps times and returns how many units
+// (steps, trials, segments) it processed, or -1 if the case can't run here.
+struct BenchmarkCase {
+	std::string name;
+	std::string unit;
+	std::function<long long(int)> Run;
+	bool endToEnd;
+};
+
+struct BenchmarkResult {
+	std::string name;
+	std::string unit;
+	int samples;
+	int reps;
+	long long ops;
+	double ns_per_op;
+	double min_ns_per_op;
+	double ops_per_sec;
+};
+
+struct BenchmarkOptions {
+	std::string out = "benchmark.json";
+	std::string filter;
+	std::string stats;
+	std::string trace;
+	int samples = 5;
+	int sweepSamples = 1;
+	double minTime = 0.5;
+	unsigned seed = 1;
+	bool render = true;
+};
+
+void RegisterWalkBenchmarks(std::vector<BenchmarkCase>& cases);
+void RegisterExportBenchmarks(std::vector<BenchmarkCase>& cases);
+bool RegisterRenderBenchmarks(std::vector<BenchmarkCase>& cases);
+void ShutdownRenderBenchmarks();
+
+bool WriteBenchmarkJson(const std::string& path, const BenchmarkOptions& opt, const std::vector<BenchmarkResult>& results);
+bool ReadBenchmarkJson(const std::string& path, std::vector<BenchmarkResult>& results);
+int CompareBenchmarks(const std::string& baseline, const std::string& current, double threshold);
+
+#endif
@@ -0,0 +1,61 @@
+/* Start Header -------------------------------------------------------
+File Name: ExportBenchmarks.cpp
+Purpose: Benchmarks of the streaming result sinks
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "RandomWalk.hpp"
+#include "ResultSink.hpp"
+
+#define EXPORT_ROWS 1000000
+
+// A million checkpoint rows of the loop-erased layout, the widest one.
+static long long ExportRows(int reps, const std::string& path)
+{
+	std::vector<ResultColumn> columns;
+	columns.push_back({ "steps", COLUMN_INT64 });
+	columns.push_back({ "ave_dist", COLUMN_FLOAT64 });
+	columns.push_back({ "ave_largest", COLUMN_FLOAT64 });
+	columns.push_back({ "ave_num_loop", COLUMN_FLOAT64 });
+
+	RunMetadata meta;
+	meta.experiment = "benchmark";
+	meta.lattice = "cubic Z^3, nearest neighbour";
+	meta.box = "unbounded";
+	meta.seed = 1;
+	meta.trials = TRIALS;
+
+	for (int r = 0; r < reps; ++r)
+	{
+		ResultSink* sink = CreateResultSink(path);
+		if (!sink->Open(path, columns, meta))
+		{
+			delete sink;
+			return 0;
+		}
+		for (int i = 0; i < EXPORT_ROWS; ++i)
+		{
+			double row[4] = { (double)i, i * 0.5, i * 0.25, i * 0.125 };
+			sink->Append(row);
+		}
+		sink->Close();
+		delete sink;
+	}
+	remove(path.c_str());
+	return (long long)reps * EXPORT_ROWS;
+}
+
+void RegisterExportBenchmarks(std::vector<BenchmarkCase>& cases)
+{
+	cases.push_back({ "Export/Arrow", "row", [](int reps) { return ExportRows(reps, "benchmark_export.arrow"); }, true });
+	cases.push_back({ "Export/Csv", "row", [](int reps) { return ExportRows(reps, "benchmark_export.csv"); }, true });
+}
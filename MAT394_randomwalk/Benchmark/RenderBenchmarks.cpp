@@ -0,0 +1,119 @@
+/* Start Header -------------------------------------------------------
+File Name: RenderBenchmarks.cpp
+Purpose: Benchmarks of the per-segment path drawing in a hidden window
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+
+#include "Benchmark.hpp"
+#include "Graph.hpp"
+#include "shader.hpp"
+#include "FrameProfiler.hpp"
+
+static GLFWwindow* window = NULL;
+static GLuint programID = 0;
+static FrameProfiler profiler;
+
+// Draws the path exactly like the frame loop in Main.cpp, one Line::Draw
+// per segment, and waits for the GPU so the time includes the driver work.
+static long long DrawPath(int reps, const std::vector<glm::vec3>& points)
+{
+	Line line;
+	line.m_Projection = glm::mat4(1.0);
+	line.m_View = glm::mat4(1.0);
+
+	for (int r = 0; r < reps; ++r)
+	{
+		profiler.BeginFrame();
+		glClear(GL_COLOR_BUFFER_BIT);
+		profiler.BeginPass(PASS_PATH);
+		for (size_t i = 0; i < points.size() - 1; ++i)
+		{
+			line.SetStartEnd(points[i], points[i + 1]);
+			line.Draw(programID, glm::vec3(0.f));
+		}
+		profiler.EndPass(PASS_PATH);
+		glFinish();
+		profiler.EndFrame();
+	}
+
+	line.Clear();
+	return (long long)reps * (long long)(points.size() - 1);
+}
+
+bool RegisterRenderBenchmarks(std::vector<BenchmarkCase>& cases)
+{
+	if (!glfwInit())
+		return false;
+
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+	window = glfwCreateWindow(640, 480, "Benchmark", NULL, NULL);
+	if (window == NULL)
+	{
+		glfwTerminate();
+		return false;
+	}
+	glfwMakeContextCurrent(window);
+
+	glewExperimental = true;
+	if (glewInit() != GLEW_OK)
+	{
+		ShutdownRenderBenchmarks();
+		return false;
+	}
+
+	profiler.Init();
+	programID = LoadShaders("../MAT394_randomwalk/VertexShader.vert", "../MAT394_randomwalk/FragmentShader.frag");
+	if (programID == 0)
+	{
+		ShutdownRenderBenchmarks();
+		return false;
+	}
+
+	for (int segments = 1000; segments <= 10000; segments *= 10)
+	{
+		RandomWalk rw;
+		for (int i = 0; i < segments; ++i)
+			rw.Walk();
+
+		std::vector<glm::vec3> points = rw.points;
+		cases.push_back({ "LineDraw/segments=" + std::to_string(segments), "segment", [points](int reps) { return DrawPath(reps, points); }, false });
+	}
+	return true;
+}
+
+void ShutdownRenderBenchmarks()
+{
+	//the same timer queries the Frame Profiler window uses, so this also
+	//checks them on a software implementation such as Mesa llvmpipe
+	if (profiler.m_frame > 2)
+		printf("Path pass over the last frames : %.3f ms CPU, %.3f ms GPU%s\n",
+			profiler.CpuAverage(PASS_PATH), profiler.GpuAverage(PASS_PATH), profiler.m_gpuTimers ? "" : " (no timer queries)");
+	profiler.Clear();
+
+	if (programID)
+		glDeleteProgram(programID);
+	programID = 0;
+
+	if (window)
+		glfwDestroyWindow(window);
+	window = NULL;
+	glfwTerminate();
+}
@@ -0,0 +1,327 @@
+/* Start Header -------------------------------------------------------
+File Name: WalkBenchmarks.cpp
+Purpose: Micro and sweep benchmarks of the walk engine and loop detection
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include "Benchmark.hpp"
+#include "RandomWalk.hpp"
+#include "LaplacianWalk.hpp"
+#include "PivotWalk.hpp"
+#include "WalkObservers.hpp"
+#include "TrajectoryAnalysis.hpp"
+#include "WalkOnSpheres.hpp"
+#include "ContinuousWalk.hpp"
+#include "GraphWalk.hpp"
+
+#define WALK_LENGTH 10000
+
+// Same box the GUI builds from the "Size of X/Y/Z" sliders.
+static void SetBox(RandomWalk& rw, int size)
+{
+	rw.limit = size > 0;
+	rw.limit_max = glm::vec3(size * 0.5f);
+	rw.limit_min = -rw.limit_max;
+}
+
+static long long WalkSteps(int reps, int box, bool looperased)
+{
+	RandomWalk rw;
+	SetBox(rw, box);
+	rw.looperased = looperased;
+
+	for (int r = 0; r < reps; ++r)
+	{
+		rw.Reset();
+		for (int j = 0; j < WALK_LENGTH; ++j)
+		{
+			rw.Walk();
+			if (looperased)
+				rw.CheckLoop();
+		}
+	}
+	return (long long)reps * WALK_LENGTH;
+}
+
+// Walk/ with a drift along x and a pull toward the origin, or without
+// backtracking, which should cost no more per step than the uniform walk.
+static long long BiasedSteps(int reps, int box, bool nonBacktracking)
+{
+	RandomWalk rw;
+	SetBox(rw, box);
+	if (nonBacktracking)
+		rw.bias.SetMemory(true, 0.2, 0.0);
+	else
+	{
+		double weights[6] = { 1.5, 1.0, 1.0, 0.5, 1.0, 1.0 };
+		rw.bias.Set(weights, 0.5);
+	}
+	rw.biased = true;
+
+	for (int r = 0; r < reps; ++r)
+	{
+		rw.Reset();
+		for (int j = 0; j < WALK_LENGTH; ++j)
+			rw.Walk();
+	}
+	return (long long)reps * WALK_LENGTH;
+}
+
+// A straight path never closes a loop: the per-step cost of loop detection
+// at that path length, which the site index keeps flat. The first call
+// indexes the path.
+static long long CheckLoopAtLength(int reps, int length)
+{
+	RandomWalk rw;
+	rw.points.clear();
+	for (int i = 0; i <= length; ++i)
+		rw.points.push_back(glm::vec3((float)i, 0.f, 0.f));
+	rw.points.push_back(glm::vec3((float)length + 1.f, 0.f, 0.f));
+
+	for (int r = 0; r < reps; ++r)
+		rw.CheckLoop();
+	return reps;
+}
+
+static long long Normal(int reps, int steps)
+{
+	RandomWalk rw;
+	float distance, range;
+	for (int r = 0; r < reps; ++r)
+		NormalSimulation(steps, rw, distance, range);
+	return (long long)reps * TRIALS;
+}
+
+// Normal walks with the gyration, span and displacement observers, against
+// NormalSimulation for what they add per step.
+static long long Shape(int reps, int steps)
+{
+	RandomWalk rw;
+	float gyration2, asphericity, span, displacement;
+	for (int r = 0; r < reps; ++r)
+		ShapeTrials(rw, steps, TRIALS, gyration2, asphericity, span, displacement);
+	return (long long)reps * TRIALS;
+}
+
+// One walk kept as direction bytes and its MSD and step autocorrelation at
+// every lag, on the calling thread.
+static long long Msd(int reps, int steps)
+{
+	RandomWalk rw;
+	std::vector<unsigned char> directions;
+	TrajectoryStats stats;
+	for (int r = 0; r < reps; ++r)
+	{
+		WalkDirections(rw, steps, directions);
+		AnalyzeTrajectory(directions, NULL, stats);
+	}
+	return (long long)reps * steps;
+}
+
+// Walks on spheres in a cube of side 100, from the centre, or from twice
+// the radius of a target ball around it.
+static long long Spheres(int reps, double target)
+{
+	SphereDomain domain;
+	domain.Set(glm::vec3(-50.f), glm::vec3(50.f), target);
+	Rng rng(1);
+	float fractions[SPHERE_BOUNDARIES], spheres;
+	for (int r = 0; r < reps; ++r)
+		SphereTrials(rng, domain, glm::dvec3(target > 0.0 ? 2.0 * target : 0.0, 0.0, 0.0), TRIALS, fractions, spheres);
+	return (long long)reps * TRIALS;
+}
+
+// Off-lattice walks a block at a time, against NormalSimulation for what
+// the normals and powers cost over a lattice step.
+static long long Continuous(int reps, int steps, WalkKernel kernel)
+{
+	RandomWalk rw;
+	rw.kernel = kernel;
+	Rng rng(1);
+	float distance, log_distance;
+	for (int r = 0; r < reps; ++r)
+		ContinuousTrials(rng, rw, steps, TRIALS, distance, log_distance);
+	return (long long)reps * TRIALS;
+}
+
+// A periodic 64^3 grid, three quarters of a million edges, with its
+// vertices numbered at random so neighbours are far apart in memory, or
+// renumbered by reverse Cuthill-McKee. The walks are the same on both.
+static const CsrGraph& GridGraph(bool rcm)
+{
+	static CsrGraph shuffled, ordered;
+	if (shuffled.offsets.empty())
+	{
+		const int n = 64;
+		std::vector<uint32_t> label(n * n * n);
+		for (size_t v = 0; v < label.size(); ++v)
+			label[v] = (uint32_t)v;
+		Rng rng(1);
+		for (size_t v = label.size() - 1; v > 0; --v)
+			std::swap(label[v], label[rng.Below((unsigned)v + 1)]);
+
+		std::vector<uint32_t> ends;
+		for (int x = 0; x < n; ++x)
+			for (int y = 0; y < n; ++y)
+				for (int z = 0; z < n; ++z)
+				{
+					int v = (x * n + y) * n + z;
+					int next[3] = { ((x + 1) % n * n + y) * n + z, (x * n + (y + 1) % n) * n + z, (x * n + y) * n + (z + 1) % n };
+					for (int d = 0; d < 3; ++d)
+					{
+						ends.push_back(label[v]);
+						ends.push_back(label[next[d]]);
+					}
+				}
+		shuffled.Build(ends);
+		ordered = shuffled;
+		ordered.Reorder(GRAPH_ORDER_RCM);
+	}
+	return rcm ? ordered : shuffled;
+}
+
+static long long GraphWalks(int reps, int steps, bool rcm, bool looperased)
+{
+	const CsrGraph& graph = GridGraph(rcm);
+	int start = graph.Vertex(0);
+	Rng rng(1);
+	float a, b, c;
+	for (int r = 0; r < reps; ++r)
+	{
+		if (looperased)
+			GraphLoopErasedTrials(graph, rng, start, steps, TRIALS, a, b, c);
+		else
+			GraphPassageTrials(graph, rng, start, start, steps, TRIALS, a, b);
+	}
+	return (long long)reps * TRIALS;
+}
+
+static long long LoopErased(int reps, int steps)
+{
+	RandomWalk rw;
+	rw.looperased = true;
+	float distance, largest, erased;
+	for (int r = 0; r < reps; ++r)
+		LoopErasedSimulation(steps, rw, distance, largest, erased);
+	return (long long)reps * TRIALS;
+}
+
+static long long Return(int reps, int steps, int box)
+{
+	RandomWalk rw;
+	SetBox(rw, box);
+	float prob;
+	for (int r = 0; r < reps; ++r)
+		ProbabilityToReturn(rw, prob, steps);
+	return (long long)reps * TRIALS;
+}
+
+// Loop-erased walks to the edge of [-radius, radius]^3, one path per rep.
+static long long BoxLoopErased(int reps, int radius, bool laplacian)
+{
+	LaplacianWalk walker;
+	float length, inner;
+	LaplacianTrials(walker, radius, reps, laplacian, length, inner);
+	return reps;
+}
+
+// Pivot attempts on an equilibrated walk of n steps; the walk carries over
+// from one measurement to the next, so only the first one pays the burn-in.
+static long long PivotAttempts(int reps, int n)
+{
+	static PivotWalk walker;
+	if ((int)walker.sites.size() != n + 1)
+	{
+		walker.Reset(n);
+		for (int i = 0; i < 100 + 20 * (int)sqrt((double)n); ++i)
+			walker.Attempt();
+	}
+	for (int r = 0; r < reps; ++r)
+		walker.Attempt();
+	return reps;
+}
+
+// The decade sweeps the "Start" and "Probability to Return to Origin"
+// buttons run, one data point per power of ten.
+static long long Sweep(int first, int last, int mode)
+{
+	RandomWalk rw;
+	rw.looperased = mode == 1;
+	float distance, range, largest, erased, prob;
+	long long trials = 0;
+	for (int steps = first; steps <= last; steps *= 10)
+	{
+		if (mode == 0)
+			NormalSimulation(steps, rw, distance, range);
+		else if (mode == 1)
+			LoopErasedSimulation(steps, rw, distance, largest, erased);
+		else
+			ProbabilityToReturn(rw, prob, steps);
+		trials += TRIALS;
+	}
+	return trials;
+}
+
+void RegisterWalkBenchmarks(std::vector<BenchmarkCase>& cases)
+{
+	const int boxes[] = { 0, 10, 100 };
+	for (int b = 0; b < 3; ++b)
+	{
+		int box = boxes[b];
+		std::string suffix = box ? "box=" + std::to_string(box) : "unbounded";
+		cases.push_back({ "Walk/" + suffix, "step", [box](int reps) { return WalkSteps(reps, box, false); }, false });
+		cases.push_back({ "LoopErasedWalk/" + suffix, "step", [box](int reps) { return WalkSteps(reps, box, true); }, false });
+		cases.push_back({ "BiasedWalk/" + suffix, "step", [box](int reps) { return BiasedSteps(reps, box, false); }, false });
+		cases.push_back({ "NonBacktrackingWalk/" + suffix, "step", [box](int reps) { return BiasedSteps(reps, box, true); }, false });
+	}
+
+	for (int length = 100; length <= 100000; length *= 10)
+		cases.push_back({ "CheckLoop/length=" + std::to_string(length), "step", [length](int reps) { return CheckLoopAtLength(reps, length); }, false });
+
+	for (int steps = 10; steps <= 10000; steps *= 10)
+	{
+		cases.push_back({ "NormalSimulation/steps=" + std::to_string(steps), "trial", [steps](int reps) { return Normal(reps, steps); }, false });
+		cases.push_back({ "ShapeSimulation/steps=" + std::to_string(steps), "trial", [steps](int reps) { return Shape(reps, steps); }, false });
+		cases.push_back({ "GaussianWalk/steps=" + std::to_string(steps), "trial", [steps](int reps) { return Continuous(reps, steps, KERNEL_GAUSSIAN); }, false });
+		cases.push_back({ "LevyFlight/steps=" + std::to_string(steps), "trial", [steps](int reps) { return Continuous(reps, steps, KERNEL_LEVY); }, false });
+	}
+	for (int steps = 10; steps <= 1000; steps *= 10)
+		cases.push_back({ "LoopErasedSimulation/steps=" + std::to_string(steps), "trial", [steps](int reps) { return LoopErased(reps, steps); }, false });
+	for (int steps = 100; steps <= 10000; steps *= 10)
+	{
+		cases.push_back({ "ProbabilityToReturn/steps=" + std::to_string(steps), "trial", [steps](int reps) { return Return(reps, steps, 0); }, false });
+		cases.push_back({ "ProbabilityToReturn/box=10/steps=" + std::to_string(steps), "trial", [steps](int reps) { return Return(reps, steps, 10); }, false });
+	}
+
+	cases.push_back({ "GraphReturn/shuffled/steps=1000", "trial", [](int reps) { return GraphWalks(reps, 1000, false, false); }, false });
+	cases.push_back({ "GraphReturn/rcm/steps=1000", "trial", [](int reps) { return GraphWalks(reps, 1000, true, false); }, false });
+	cases.push_back({ "GraphLoopErased/shuffled/steps=1000", "trial", [](int reps) { return GraphWalks(reps, 1000, false, true); }, false });
+	cases.push_back({ "GraphLoopErased/rcm/steps=1000", "trial", [](int reps) { return GraphWalks(reps, 1000, true, true); }, false });
+
+	for (int radius = 4; radius <= 16; radius *= 2)
+	{
+		cases.push_back({ "ExitErased/radius=" + std::to_string(radius), "path", [radius](int reps) { return BoxLoopErased(reps, radius, false); }, false });
+		cases.push_back({ "Laplacian/radius=" + std::to_string(radius), "path", [radius](int reps) { return BoxLoopErased(reps, radius, true); }, false });
+	}
+	for (int n = 1000; n <= 100000; n *= 10)
+		cases.push_back({ "Pivot/N=" + std::to_string(n), "attempt", [n](int reps) { return PivotAttempts(reps, n); }, false });
+	cases.push_back({ "WalkOnSpheres/box=100", "walk", [](int reps) { return Spheres(reps, 0.0); }, false });
+	cases.push_back({ "WalkOnSpheres/box=100/target=10", "walk", [](int reps) { return Spheres(reps, 10.0); }, false });
+	for (int steps = 10000; steps <= 1000000; steps *= 10)
+		cases.push_back({ "TrajectoryMsd/steps=" + std::to_string(steps), "step", [steps](int reps) { return Msd(reps, steps); }, false });
+
+	cases.push_back({ "Sweep/Normal/10-100000", "trial", [](int) { return Sweep(10, 100000, 0); }, true });
+	cases.push_back({ "Sweep/LoopErased/10-1000", "trial", [](int) { return Sweep(10, 1000, 1); }, true });
+	cases.push_back({ "Sweep/ProbabilityToReturn/100-100000", "trial", [](int) { return Sweep(100, 100000, 2); }, true });
+}
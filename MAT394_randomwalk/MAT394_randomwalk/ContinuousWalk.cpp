@@ -0,0 +1,201 @@
+/* Start Header -------------------------------------------------------
+File Name: ContinuousWalk.cpp
+Purpose: Off-lattice walks: Gaussian steps and Levy flights
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+#include <algorithm>
+
+#include "ContinuousWalk.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+//start of the tail and area of every layer for 128 layers
+#define ZIGGURAT_R 3.442619855899
+#define ZIGGURAT_V 9.91256303526217e-3
+
+//standard deviation per axis of a Gaussian step with a mean squared length of 1
+#define GAUSSIAN_SIGMA 0.57735026918962576
+
+const Ziggurat ziggurat;
+
+Ziggurat::Ziggurat()
+{
+	const double m = 2147483648.0;
+	double d = ZIGGURAT_R;
+	double t = d;
+	double q = ZIGGURAT_V / exp(-0.5 * d * d);
+	k[0] = (uint32_t)(d / q * m);
+	k[1] = 0;
+	w[0] = q / m;
+	w[127] = d / m;
+	f[0] = 1.0;
+	f[127] = exp(-0.5 * d * d);
+	for (int i = 126; i >= 1; --i)
+	{
+		d = sqrt(-2.0 * log(ZIGGURAT_V / d + exp(-0.5 * d * d)));
+		k[i + 1] = (uint32_t)(d / t * m);
+		t = d;
+		f[i] = exp(-0.5 * d * d);
+		w[i] = d / m;
+	}
+}
+
+double Ziggurat::Tail(Rng& rng, int32_t h, int layer) const
+{
+	for (;;)
+	{
+		double x = h * w[layer];
+		if (layer == 0)
+		{
+			//the base layer holds everything beyond R, drawn by Marsaglia's method
+			double y;
+			do
+			{
+				x = -log(1.0 - rng.Uniform()) / ZIGGURAT_R;
+				y = -log(1.0 - rng.Uniform());
+			} while (y + y < x * x);
+			return h > 0 ? ZIGGURAT_R + x : -ZIGGURAT_R - x;
+		}
+		if (f[layer] + rng.Uniform() * (f[layer - 1] - f[layer]) < exp(-0.5 * x * x))
+			return x;
+
+		uint64_t r = rng.Next();
+		h = (int32_t)(r >> 32);
+		layer = (int)(r & 127);
+		uint32_t size = h < 0 ? 0u - (uint32_t)h : (uint32_t)h;
+		if (size < k[layer])
+			return h * w[layer];
+	}
+}
+
+void FillNormal(Rng& rng, double* out, int n)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = ziggurat.Normal(rng);
+}
+
+// The uniforms first, then the powers in a loop of their own that the
+// compiler can vectorize.
+void FillPowerLaw(Rng& rng, double* out, int n, double alpha)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = 1.0 - rng.Uniform();
+	double exponent = -1.0 / alpha;
+	for (int i = 0; i < n; ++i)
+		out[i] = pow(out[i], exponent);
+}
+
+glm::dvec3 ContinuousStep(Rng& rng, WalkKernel kernel, double alpha)
+{
+	glm::dvec3 step;
+	step.x = ziggurat.Normal(rng);
+	step.y = ziggurat.Normal(rng);
+	step.z = ziggurat.Normal(rng);
+	if (kernel == KERNEL_GAUSSIAN)
+		return step * GAUSSIAN_SIGMA;
+
+	double length;
+	FillPowerLaw(rng, &length, 1, alpha);
+	return step * (length / glm::length(step));
+}
+
+void ContinuousTrials(Rng& rng, const RandomWalk& walker, int steps, int trials, float& distance, float& log_distance)
+{
+	TRACE_ZONE("ContinuousTrials");
+	StatBusy busy;
+	bool levy = walker.kernel == KERNEL_LEVY;
+	glm::dvec3 start(walker.startPosition);
+	glm::dvec3 low(walker.limit_min);
+	glm::dvec3 high(walker.limit_max);
+
+	double x[CONTINUOUS_BLOCK], y[CONTINUOUS_BLOCK], z[CONTINUOUS_BLOCK];
+	double dx[CONTINUOUS_BLOCK], dy[CONTINUOUS_BLOCK], dz[CONTINUOUS_BLOCK];
+	double length[CONTINUOUS_BLOCK];
+	double distance_sum = 0.0;
+	double log_sum = 0.0;
+	long long rejections = 0;
+
+	for (int first = 0; first < trials; first += CONTINUOUS_BLOCK)
+	{
+		int n = std::min(CONTINUOUS_BLOCK, trials - first);
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] = start.x;
+			y[i] = start.y;
+			z[i] = start.z;
+		}
+
+		for (int s = 0; s < steps; ++s)
+		{
+			FillNormal(rng, dx, n);
+			FillNormal(rng, dy, n);
+			FillNormal(rng, dz, n);
+			if (levy)
+			{
+				FillPowerLaw(rng, length, n, walker.alpha);
+				for (int i = 0; i < n; ++i)
+				{
+					double scale = length[i] / sqrt(dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i]);
+					dx[i] *= scale;
+					dy[i] *= scale;
+					dz[i] *= scale;
+				}
+			}
+			else
+			{
+				for (int i = 0; i < n; ++i)
+				{
+					dx[i] *= GAUSSIAN_SIGMA;
+					dy[i] *= GAUSSIAN_SIGMA;
+					dz[i] *= GAUSSIAN_SIGMA;
+				}
+			}
+
+			if (walker.limit)
+			{
+				//the few steps that leave the box are drawn again one by one
+				for (int i = 0; i < n; ++i)
+				{
+					glm::dvec3 to(x[i] + dx[i], y[i] + dy[i], z[i] + dz[i]);
+					while (to.x < low.x || to.y < low.y || to.z < low.z
+						|| to.x > high.x || to.y > high.y || to.z > high.z)
+					{
+						++rejections;
+						to = glm::dvec3(x[i], y[i], z[i]) + ContinuousStep(rng, walker.kernel, walker.alpha);
+					}
+					dx[i] = to.x - x[i];
+					dy[i] = to.y - y[i];
+					dz[i] = to.z - z[i];
+				}
+			}
+
+			for (int i = 0; i < n; ++i)
+			{
+				x[i] += dx[i];
+				y[i] += dy[i];
+				z[i] += dz[i];
+			}
+		}
+
+		for (int i = 0; i < n; ++i)
+		{
+			double r = sqrt((x[i] - start.x) * (x[i] - start.x) + (y[i] - start.y) * (y[i] - start.y)
+				+ (z[i] - start.z) * (z[i] - start.z));
+			distance_sum += r;
+			log_sum += log(r);
+		}
+		StatAdd(STAT_STEPS, (long long)n * steps);
+		StatAdd(STAT_TRIALS, n);
+	}
+
+	if (rejections)
+		StatAdd(STAT_REJECTIONS, rejections);
+	distance = (float)(distance_sum / trials);
+	log_distance = (float)(log_sum / trials);
+}
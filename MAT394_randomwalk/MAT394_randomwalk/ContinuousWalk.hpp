@@ -0,0 +1,68 @@
+/* Start Header -------------------------------------------------------
+File Name: ContinuousWalk.hpp
+Purpose: Off-lattice walks: Gaussian steps and Levy flights
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef CONTINUOUSWALK_HPP
+#define CONTINUOUSWALK_HPP
+
+#include <math.h>
+#include <stdint.h>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+#include "RandomWalk.hpp"
+
+//walkers stepped together by ContinuousTrials
+#define CONTINUOUS_BLOCK 256
+
+// Ziggurat of Marsaglia and Tsang with 128 layers. A draw is one 64-bit
+// number: 32 bits place the point in its layer and 7 others pick the layer,
+// so the two are independent; 98.8% of draws stop at the first test.
+struct Ziggurat {
+	uint32_t k[128];
+	double w[128];
+	double f[128];
+
+	Ziggurat();
+	double Tail(Rng& rng, int32_t h, int layer) const;
+
+	double Normal(Rng& rng) const
+	{
+		uint64_t r = rng.Next();
+		int32_t h = (int32_t)(r >> 32);
+		int layer = (int)(r & 127);
+		uint32_t size = h < 0 ? 0u - (uint32_t)h : (uint32_t)h;
+		if (size < k[layer])
+			return h * w[layer];
+		return Tail(rng, h, layer);
+	}
+};
+
+extern const Ziggurat ziggurat;
+
+// n standard normals into out.
+void FillNormal(Rng& rng, double* out, int n);
+
+// n Pareto lengths, P(length > l) = l^-alpha for l >= 1.
+void FillPowerLaw(Rng& rng, double* out, int n, double alpha);
+
+// One step of an off-lattice kernel: Gaussian with a mean squared length
+// of 1 like a lattice step, or a Pareto length in a uniform direction.
+glm::dvec3 ContinuousStep(Rng& rng, WalkKernel kernel, double alpha);
+
+// trials walks of steps steps with walker's kernel and box, where a step
+// that would leave the box is drawn again. Positions are kept as separate
+// x, y and z arrays over a block of walkers, so the updates run as plain
+// loops over the block. distance is the average distance from the start,
+// log_distance the average of its log, which grows as log(steps) / alpha
+// for a flight and half that for diffusion, whether the mean exists or not.
+void ContinuousTrials(Rng& rng, const RandomWalk& walker, int steps, int trials, float& distance, float& log_distance);
+
+#endif
@@ -0,0 +1,170 @@
+/* Start Header -------------------------------------------------------
+File Name: EngineStats.cpp
+Purpose: Registration, aggregation and JSON dump of engine counters
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+
+#include "EngineStats.hpp"
+
+const char* StatNames[STAT_COUNT] = {
+	"steps",
+	"boundary_rejections",
+	"loops_erased",
+	"probes",
+	"allocations",
+	"trials"
+};
+
+static ThreadStats slots[MAX_STAT_THREADS];
+static std::atomic<int> slotCount(0);
+static ThreadStats overflow;
+static std::mutex slotMutex;
+
+thread_local ThreadStats* localStats = NULL;
+
+// Gives the slot of a thread back when the thread exits; anything counted
+// after that, from other thread_local destructors, goes to the shared slot.
+struct StatsSlotRelease {
+	~StatsSlotRelease()
+	{
+		std::lock_guard<std::mutex> lock(slotMutex);
+		if (localStats && !localStats->shared)
+			localStats->in_use.store(false, std::memory_order_relaxed);
+		overflow.shared = true;
+		localStats = &overflow;
+	}
+};
+
+static long long NowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ThreadStats* RegisterStatsThread(const char* name)
+{
+	if (localStats)
+		return localStats;
+	thread_local StatsSlotRelease release;
+	(void)release;
+
+	//a name only ever belongs to its first slot, so readers need no lock
+	std::lock_guard<std::mutex> lock(slotMutex);
+	int count = slotCount.load();
+	for (int i = 0; i < count; ++i)
+	{
+		if (!slots[i].in_use.load(std::memory_order_relaxed) && strcmp(slots[i].name, name) == 0)
+		{
+			slots[i].in_use.store(true, std::memory_order_relaxed);
+			localStats = &slots[i];
+			return localStats;
+		}
+	}
+	if (count == MAX_STAT_THREADS)
+	{
+		overflow.shared = true;
+		localStats = &overflow;
+		return localStats;
+	}
+
+	localStats = &slots[count];
+	strncpy(localStats->name, name, sizeof(localStats->name) - 1);
+	localStats->in_use.store(true, std::memory_order_relaxed);
+	slotCount.store(count + 1);
+	return localStats;
+}
+
+StatBusy::StatBusy()
+{
+	if (!localStats)
+		RegisterStatsThread("thread");
+	start = NowNs();
+	localStats->busy_since.store(start, std::memory_order_relaxed);
+}
+
+StatBusy::~StatBusy()
+{
+	std::atomic<long long>& busy = localStats->busy_ns;
+	if (localStats->shared)
+		busy.fetch_add(NowNs() - start, std::memory_order_relaxed);
+	else
+		busy.store(busy.load(std::memory_order_relaxed) + NowNs() - start, std::memory_order_relaxed);
+	localStats->busy_since.store(0, std::memory_order_relaxed);
+}
+
+void TakeStatsSnapshot(StatsSnapshot& snapshot)
+{
+	int count = slotCount.load();
+	long long now = NowNs();
+	snapshot.time = now * 1e-9;
+	snapshot.steps.resize(count);
+	snapshot.busy_ns.resize(count);
+	snapshot.names.resize(count);
+	snapshot.running.resize(count);
+
+	for (int c = 0; c < STAT_COUNT; ++c)
+		snapshot.total[c] = overflow.counters[c].load(std::memory_order_relaxed);
+
+	for (int i = 0; i < count; ++i)
+	{
+		for (int c = 0; c < STAT_COUNT; ++c)
+			snapshot.total[c] += slots[i].counters[c].load(std::memory_order_relaxed);
+		snapshot.steps[i] = slots[i].counters[STAT_STEPS].load(std::memory_order_relaxed);
+		//count the running StatBusy scope too, not only finished ones
+		long long since = slots[i].busy_since.load(std::memory_order_relaxed);
+		snapshot.busy_ns[i] = slots[i].busy_ns.load(std::memory_order_relaxed) + (since ? now - since : 0);
+		snapshot.names[i] = slots[i].name;
+		snapshot.running[i] = slots[i].in_use.load(std::memory_order_relaxed);
+	}
+}
+
+// Only the owning threads write their slots, so this is a best effort reset
+// meant for the moments no experiment is running.
+void ResetStats()
+{
+	int count = slotCount.load();
+	for (int i = 0; i < count; ++i)
+	{
+		for (int c = 0; c < STAT_COUNT; ++c)
+			slots[i].counters[c].store(0, std::memory_order_relaxed);
+		slots[i].busy_ns.store(0, std::memory_order_relaxed);
+	}
+	for (int c = 0; c < STAT_COUNT; ++c)
+		overflow.counters[c].store(0, std::memory_order_relaxed);
+}
+
+bool WriteStatsJson(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	StatsSnapshot snapshot;
+	TakeStatsSnapshot(snapshot);
+
+	fprintf(file, "{\n\t\"totals\": {");
+	for (int c = 0; c < STAT_COUNT; ++c)
+		fprintf(file, "%s \"%s\": %lld", c ? "," : "", StatNames[c], snapshot.total[c]);
+	fprintf(file, " },\n\t\"threads\": [\n");
+	for (size_t i = 0; i < snapshot.steps.size(); ++i)
+	{
+		fprintf(file, "\t\t{ \"name\": \"%s\"", snapshot.names[i]);
+		for (int c = 0; c < STAT_COUNT; ++c)
+			fprintf(file, ", \"%s\": %lld", StatNames[c], slots[i].counters[c].load(std::memory_order_relaxed));
+		fprintf(file, ", \"busy_seconds\": %.6f }%s\n", snapshot.busy_ns[i] * 1e-9, i + 1 < snapshot.steps.size() ? "," : "");
+	}
+	fprintf(file, "\t]\n}\n");
+	fclose(file);
+	return true;
+}
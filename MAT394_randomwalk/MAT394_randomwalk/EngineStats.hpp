@@ -0,0 +1,87 @@
+/* Start Header -------------------------------------------------------
+File Name: EngineStats.hpp
+Purpose: Per-thread performance counters of the walk engine
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef ENGINESTATS_HPP
+#define ENGINESTATS_HPP
+
+#include <atomic>
+#include <vector>
+
+#define MAX_STAT_THREADS 64
+
+enum StatCounter {
+	STAT_STEPS,
+	STAT_REJECTIONS,
+	STAT_LOOPS_ERASED,
+	STAT_PROBES,
+	STAT_ALLOCATIONS,
+	STAT_TRIALS,
+	STAT_COUNT
+};
+
+extern const char* StatNames[STAT_COUNT];
+
+// Each thread owns one slot and is its only writer, so a relaxed load/store
+// pair is enough to count and readers sum the slots without any lock.
+// A thread hands its slot back when it exits, and the next thread of the
+// same name carries on counting in it. Threads that find no slot free share
+// one, which counts with atomic adds instead.
+struct alignas(64) ThreadStats {
+	std::atomic<long long> counters[STAT_COUNT];
+	std::atomic<long long> busy_ns;
+	std::atomic<long long> busy_since;
+	std::atomic<bool> in_use;
+	bool shared;
+	char name[32];
+};
+
+struct StatsSnapshot {
+	double time;
+	long long total[STAT_COUNT];
+	std::vector<long long> steps;
+	std::vector<long long> busy_ns;
+	std::vector<const char*> names;
+	std::vector<char> running;
+};
+
+ThreadStats* RegisterStatsThread(const char* name);
+extern thread_local ThreadStats* localStats;
+
+inline void StatAdd(StatCounter counter, long long n = 1)
+{
+#ifndef RW_NO_STATS
+	if (!localStats)
+		RegisterStatsThread("thread");
+	std::atomic<long long>& value = localStats->counters[counter];
+	if (localStats->shared)
+		value.fetch_add(n, std::memory_order_relaxed);
+	else
+		value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+#else
+	(void)counter;
+	(void)n;
+#endif
+}
+
+// Marks the enclosing scope as busy time of the calling thread.
+class StatBusy {
+public:
+	StatBusy();
+	~StatBusy();
+private:
+	long long start;
+};
+
+void TakeStatsSnapshot(StatsSnapshot& snapshot);
+void ResetStats();
+bool WriteStatsJson(const char* path);
+
+#endif
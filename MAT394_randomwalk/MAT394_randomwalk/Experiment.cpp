@@ -0,0 +1,1498 @@
+/* Start Header -------------------------------------------------------
+File Name: Experiment.cpp
+Purpose: Experiment specification files and the batch experiment runner
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdio.h>
+#include <math.h>
+#include <limits.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+
+#include "Experiment.hpp"
+#include "Json.hpp"
+#include "ThreadPool.hpp"
+#include "ResultCache.hpp"
+#include "Trace.hpp"
+#include "LaplacianWalk.hpp"
+#include "SpanningTree.hpp"
+#include "PivotWalk.hpp"
+#include "WalkObservers.hpp"
+#include "TrajectoryAnalysis.hpp"
+#include "LoopHistograms.hpp"
+#include "WalkOnSpheres.hpp"
+#include "ContinuousWalk.hpp"
+
+#define CHUNK_TRIALS 100
+
+const char* WalkKindNames[WALK_KIND_COUNT] = {
+	"normal",
+	"loop_erased",
+	"return",
+	"exit_erased",
+	"laplacian",
+	"spanning_tree",
+	"saw",
+	"shape",
+	"walk_on_spheres",
+	"gaussian",
+	"levy",
+	"graph_return",
+	"graph_hitting",
+	"graph_loop_erased"
+};
+
+static const char* SpecKeys[] = {
+	"name", "walk", "lattice", "dimension", "box", "horizons",
+	"trials", "target_error", "max_trials", "seed", "output", "tree_output", "msd_output",
+	"censored", "return_time_output", "target_radius", "alpha", "weights", "pull", "persistence", "reversal",
+	"graph", "reorder", "start", "target", "grid"
+};
+
+static const char* GridAxes[] = {
+	"walk", "box", "seed", "trials"
+};
+
+static bool SpecError(std::string& error, const std::string& where, const std::string& message)
+{
+	error = where + ": " + message;
+	return false;
+}
+
+// A number that can be cast to an int; ParseJson only keeps finite ones.
+static bool IsInt(const JsonValue& value)
+{
+	return value.type == JSON_NUMBER && value.number >= INT_MIN && value.number <= INT_MAX;
+}
+
+static bool ReadHorizons(const JsonValue& value, int minimum, std::vector<int>& horizons)
+{
+	if (value.type == JSON_ARRAY)
+	{
+		for (size_t i = 0; i < value.items.size(); ++i)
+		{
+			if (!IsInt(value.items[i]) || value.items[i].number < minimum)
+				return false;
+			horizons.push_back((int)value.items[i].number);
+		}
+		return !horizons.empty();
+	}
+	if (value.type == JSON_OBJECT)
+	{
+		const JsonValue* from = value.Find("from");
+		const JsonValue* to = value.Find("to");
+		const JsonValue* factor = value.Find("factor");
+		if (!from || !to || !IsInt(*from) || !IsInt(*to) || from->number < 1)
+			return false;
+		double f = factor && factor->type == JSON_NUMBER ? factor->number : 10.0;
+		if (f <= 1.0)
+			return false;
+		for (double steps = from->number; steps <= to->number * (1.0 + 1e-9); steps *= f)
+			horizons.push_back((int)std::min(steps + 0.5, (double)INT_MAX));
+		return !horizons.empty();
+	}
+	return false;
+}
+
+static bool ReadOutputs(const JsonValue* output, const std::string& name, std::vector<std::string>& outputs)
+{
+	if (!output)
+		outputs.push_back(name + ".arrow");
+	else if (output->type == JSON_STRING)
+		outputs.push_back(output->string);
+	else if (output->type == JSON_ARRAY)
+	{
+		for (size_t i = 0; i < output->items.size(); ++i)
+		{
+			if (output->items[i].type != JSON_STRING)
+				return false;
+			outputs.push_back(output->items[i].string);
+		}
+	}
+	else
+		return false;
+	return true;
+}
+
+static bool ReadSpec(const JsonValue& value, const std::string& where, const std::string& fallbackName, ExperimentSpec& spec, std::string& error)
+{
+	if (value.type != JSON_OBJECT)
+		return SpecError(error, where, "an experiment must be an object");
+
+	//a misspelled key would otherwise silently run the defaults
+	for (size_t i = 0; i < value.keys.size(); ++i)
+	{
+		if (std::find(std::begin(SpecKeys), std::end(SpecKeys), value.keys[i]) == std::end(SpecKeys))
+			return SpecError(error, where, "unknown key \"" + value.keys[i] + "\"");
+	}
+
+	const JsonValue* name = value.Find("name");
+	spec.name = name && name->type == JSON_STRING ? name->string : fallbackName;
+
+	const JsonValue* walk = value.Find("walk");
+	if (!walk || walk->type != JSON_STRING)
+		return SpecError(error, where, "\"walk\" is required (normal, loop_erased, return, exit_erased, laplacian, spanning_tree, saw, shape, walk_on_spheres, gaussian, levy, graph_return, graph_hitting or graph_loop_erased)");
+	int kind = 0;
+	while (kind < WALK_KIND_COUNT && walk->string != WalkKindNames[kind])
+		++kind;
+	if (kind == WALK_KIND_COUNT)
+		return SpecError(error, where, "unknown walk \"" + walk->string + "\"");
+	spec.walk = (WalkKind)kind;
+
+	const JsonValue* lattice = value.Find("lattice");
+	spec.lattice = lattice && lattice->type == JSON_STRING ? lattice->string : "cubic";
+	if (spec.lattice != "cubic")
+		return SpecError(error, where, "only the cubic lattice is supported");
+
+	const JsonValue* dimension = value.Find("dimension");
+	if (dimension && dimension->type == JSON_NUMBER && dimension->number != 3.0)
+		return SpecError(error, where, "only dimension 3 is supported");
+	spec.dimension = 3;
+
+	//same box the GUI builds from the "Size of X/Y/Z" sliders; below a size
+	//of 2 the origin has no neighbour inside, and a walk that can never step
+	//retries forever
+	const JsonValue* box = value.Find("box");
+	spec.limit = false;
+	spec.limit_min = glm::vec3(-200.f);
+	spec.limit_max = glm::vec3(200.f);
+	if (box && box->type == JSON_NUMBER)
+	{
+		if (!IsInt(*box) || box->number < 2.0)
+			return SpecError(error, where, "\"box\" must be a size from 2 to 2147483647");
+		spec.limit = true;
+		spec.limit_max = glm::vec3((float)box->number * 0.5f);
+		spec.limit_min = -spec.limit_max;
+	}
+	else if (box && box->type == JSON_ARRAY && box->items.size() == 3)
+	{
+		spec.limit = true;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (box->items[i].type != JSON_NUMBER)
+				return SpecError(error, where, "\"box\" must be a size or [x, y, z] sizes");
+			if (!IsInt(box->items[i]) || box->items[i].number <= 0.0)
+				return SpecError(error, where, "\"box\" sizes must be positive, at most 2147483647");
+			spec.limit_max[i] = (float)box->items[i].number * 0.5f;
+		}
+		if (std::max(spec.limit_max.x, std::max(spec.limit_max.y, spec.limit_max.z)) < 1.f)
+			return SpecError(error, where, "one of the \"box\" sizes must be at least 2");
+		spec.limit_min = -spec.limit_max;
+	}
+	else if (box && box->type != JSON_NULL)
+		return SpecError(error, where, "\"box\" must be a size or [x, y, z] sizes");
+
+	//exit_erased and laplacian walk until they leave [-h, h]^3, so h is a
+	//radius and "box" is not used. spanning_tree samples uniform trees of an
+	//h x h x h box, one per trial. saw runs the pivot algorithm on walks of
+	//h steps with one attempt per trial; every chunk is its own chain, so
+	//the error comes from independent chains. shape is the normal walk with
+	//its gyration, asphericity, span and reach measured online.
+	const JsonValue* horizons = value.Find("horizons");
+	if (horizons)
+	{
+		if (!ReadHorizons(*horizons, spec.walk == WALK_SPHERES ? 0 : 1, spec.horizons))
+			return SpecError(error, where, "\"horizons\" must be a list of steps or { \"from\", \"to\", \"factor\" }");
+	}
+	else
+	{
+		if (spec.walk == WALK_EXIT_ERASED || spec.walk == WALK_LAPLACIAN)
+		{
+			for (int radius = 2; radius <= 16; radius *= 2)
+				spec.horizons.push_back(radius);
+		}
+		else if (spec.walk == WALK_SPANNING_TREE)
+		{
+			for (int n = 8; n <= 64; n *= 2)
+				spec.horizons.push_back(n);
+		}
+		else if (spec.walk == WALK_SAW)
+		{
+			for (int steps = 100; steps <= 100000; steps *= 10)
+				spec.horizons.push_back(steps);
+		}
+		else if (spec.walk == WALK_SPHERES)
+		{
+			//from the centre, or halfway out from the target, once both are read
+		}
+		else
+		{
+			for (int steps = spec.walk == WALK_RETURN ? 100 : 10; steps < 1000000; steps *= 10)
+				spec.horizons.push_back(steps);
+		}
+	}
+	for (size_t h = 0; h < spec.horizons.size() && spec.walk == WALK_SAW; ++h)
+	{
+		if (spec.horizons[h] < 2 || spec.horizons[h] >= (1 << 21))
+			return SpecError(error, where, "saw horizons must be from 2 to 2097151 steps");
+	}
+
+	//walk_on_spheres is Brownian motion in the box, started at (h, 0, 0),
+	//h = 0 allowed; it gives the fraction of walks that hit the ball of
+	//radius "target_radius" around the origin, if any, and the fraction that
+	//left through each face
+	const JsonValue* radius = value.Find("target_radius");
+	if (radius && (radius->type != JSON_NUMBER || radius->number < 0.0 || spec.walk != WALK_SPHERES))
+		return SpecError(error, where, "\"target_radius\" is a radius for a walk_on_spheres walk");
+	spec.target_radius = radius ? radius->number : 0.0;
+	if (spec.walk == WALK_SPHERES)
+	{
+		if (!spec.limit)
+			return SpecError(error, where, "walk_on_spheres needs a \"box\"");
+		if (spec.horizons.empty())
+			spec.horizons.push_back(spec.target_radius > 0.0 ? (int)((spec.target_radius + spec.limit_max.x) * 0.5) : 0);
+		if (spec.target_radius >= std::min(spec.limit_max.x, std::min(spec.limit_max.y, spec.limit_max.z)))
+			return SpecError(error, where, "the target ball must fit in the box");
+		for (size_t h = 0; h < spec.horizons.size(); ++h)
+		{
+			if ((spec.target_radius > 0.0 && spec.horizons[h] <= spec.target_radius) || spec.horizons[h] >= spec.limit_max.x)
+				return SpecError(error, where, "walk_on_spheres horizons are starting points between the target and the box");
+		}
+	}
+
+	//gaussian and levy step off the lattice, see ContinuousWalk.hpp; a levy
+	//step has the tail P(length > l) = l^-alpha
+	const JsonValue* alpha = value.Find("alpha");
+	if (alpha && (alpha->type != JSON_NUMBER || spec.walk != WALK_LEVY))
+		return SpecError(error, where, "\"alpha\" is the tail exponent of a levy walk");
+	spec.alpha = alpha ? alpha->number : 1.5;
+	//below 0.1 the longest flights overflow a double
+	if (spec.alpha < 0.1 || spec.alpha > 2.0)
+		return SpecError(error, where, "\"alpha\" must be from 0.1 to 2");
+
+	//"weights" for +x, +y, +z, -x, -y, -z, and a "pull" that multiplies the
+	//weight of every step back toward the origin by 1 + pull, see
+	//StepDistribution.hpp
+	bool stepped = spec.walk == WALK_NORMAL || spec.walk == WALK_LOOP_ERASED || spec.walk == WALK_RETURN || spec.walk == WALK_SHAPE;
+	const JsonValue* weights = value.Find("weights");
+	for (int d = 0; d < 6; ++d)
+		spec.weights[d] = 1.0;
+	if (weights)
+	{
+		if (weights->type != JSON_ARRAY || weights->items.size() != 6 || !stepped)
+			return SpecError(error, where, "\"weights\" are six step weights for a normal, loop_erased, return or shape walk");
+		for (int d = 0; d < 6; ++d)
+		{
+			if (weights->items[d].type != JSON_NUMBER || weights->items[d].number <= 0.0)
+				return SpecError(error, where, "step weights must be positive");
+			spec.weights[d] = weights->items[d].number;
+		}
+	}
+	const JsonValue* pull = value.Find("pull");
+	if (pull && (pull->type != JSON_NUMBER || pull->number < 0.0 || !stepped))
+		return SpecError(error, where, "\"pull\" is a bias toward the origin for a normal, loop_erased, return or shape walk");
+	spec.pull = pull ? pull->number : 0.0;
+
+	//the chances to repeat and to undo the last step, the four turns share
+	//the rest; either alone leaves the other the share of a turn, so
+	//"reversal": 0 is the non-backtracking walk. A walk in a box whose
+	//every step with weight is blocked steps as if it had no last step
+	const JsonValue* persistence = value.Find("persistence");
+	const JsonValue* reversal = value.Find("reversal");
+	if ((persistence && (persistence->type != JSON_NUMBER || !stepped)) || (reversal && (reversal->type != JSON_NUMBER || !stepped)))
+		return SpecError(error, where, "\"persistence\" and \"reversal\" are probabilities for a normal, loop_erased, return or shape walk");
+	spec.correlated = persistence || reversal;
+	spec.persistence = persistence ? persistence->number : reversal ? (1.0 - reversal->number) / 5.0 : 1.0 / 6.0;
+	spec.reversal = reversal ? reversal->number : (1.0 - spec.persistence) / 5.0;
+	if (spec.persistence < 0.0 || spec.reversal < 0.0 || spec.persistence + spec.reversal > 1.0)
+		return SpecError(error, where, "\"persistence\" and \"reversal\" must be probabilities that add up to at most 1");
+
+	const JsonValue* trials = value.Find("trials");
+	if (trials && trials->type == JSON_NUMBER && (!IsInt(*trials) || trials->number < 1))
+		return SpecError(error, where, "\"trials\" must be from 1 to 2147483647");
+	spec.trials = trials && trials->type == JSON_NUMBER ? (int)trials->number : TRIALS;
+
+	const JsonValue* target = value.Find("target_error");
+	spec.target_error = target && target->type == JSON_NUMBER ? target->number : 0.0;
+	const JsonValue* maxTrials = value.Find("max_trials");
+	if (maxTrials && maxTrials->type == JSON_NUMBER && !IsInt(*maxTrials))
+		return SpecError(error, where, "\"max_trials\" must be at most 2147483647");
+	spec.max_trials = maxTrials && maxTrials->type == JSON_NUMBER ? (int)maxTrials->number : (int)std::min(spec.trials * 100.0, (double)INT_MAX);
+	if (spec.target_error <= 0.0)
+		spec.max_trials = spec.trials;
+	if (spec.max_trials < spec.trials)
+		return SpecError(error, where, "\"max_trials\" is smaller than \"trials\"");
+
+	const JsonValue* seed = value.Find("seed");
+	//2^64, past the last seed
+	if (seed && seed->type == JSON_NUMBER && (seed->number < 0.0 || seed->number >= 18446744073709551616.0))
+		return SpecError(error, where, "\"seed\" must be from 0 to 2^64 - 1");
+	spec.seed = seed && seed->type == JSON_NUMBER ? (unsigned long long)seed->number : 1;
+
+	if (!ReadOutputs(value.Find("output"), spec.name, spec.outputs))
+		return SpecError(error, where, "\"output\" must be a file name or a list of them");
+
+	//one more tree of the last horizon, in the format the window loads
+	const JsonValue* tree = value.Find("tree_output");
+	if (tree && (tree->type != JSON_STRING || spec.walk != WALK_SPANNING_TREE))
+		return SpecError(error, where, "\"tree_output\" is a file name for a spanning_tree walk");
+	spec.tree_output = tree ? tree->string : "";
+
+	//time-averaged MSD and step autocorrelation of one more walk of the last
+	//horizon
+	const JsonValue* msd = value.Find("msd_output");
+	if (msd && (msd->type != JSON_STRING || spec.walk != WALK_NORMAL))
+		return SpecError(error, where, "\"msd_output\" is a file name for a normal walk");
+	spec.msd_output = msd ? msd->string : "";
+
+	//a censored return spec runs "trials" walks once to the last horizon,
+	//each stopped at its first return, and reads every horizon off the
+	//distribution of return times, which "return_time_output" names a file for
+	const JsonValue* censored = value.Find("censored");
+	if (censored && (censored->type != JSON_BOOL || spec.walk != WALK_RETURN))
+		return SpecError(error, where, "\"censored\" is true or false for a return walk");
+	spec.censored = censored && censored->boolean;
+	if (spec.censored && spec.target_error > 0.0)
+		return SpecError(error, where, "a censored spec runs a fixed number of trials, drop \"target_error\"");
+	//every horizon h ends a bin at h + 1
+	for (size_t h = 0; h < spec.horizons.size() && spec.censored; ++h)
+	{
+		if (spec.horizons[h] == INT_MAX)
+			return SpecError(error, where, "censored horizons must be below 2147483647");
+	}
+	const JsonValue* times = value.Find("return_time_output");
+	if (times && (times->type != JSON_STRING || !spec.censored))
+		return SpecError(error, where, "\"return_time_output\" is a file name for a censored return walk");
+	spec.return_time_output = times ? times->string : "";
+
+	//graph walks go h steps on the edge list "graph" from vertex "start",
+	//see GraphWalk.hpp; "reorder" changes the speed, not the numbers, and
+	//LoadExperimentGraphs reads the graphs once the specs are in
+	bool onGraph = spec.walk == WALK_GRAPH_RETURN || spec.walk == WALK_GRAPH_HITTING || spec.walk == WALK_GRAPH_LOOP_ERASED;
+	const JsonValue* graph = value.Find("graph");
+	if (graph && (graph->type != JSON_STRING || !onGraph))
+		return SpecError(error, where, "\"graph\" is an edge list file for a graph walk");
+	if (onGraph && !graph)
+		return SpecError(error, where, "a graph walk needs a \"graph\"");
+	spec.graph = graph ? graph->string : "";
+	const JsonValue* reorder = value.Find("reorder");
+	if (reorder && (reorder->type != JSON_STRING || !onGraph))
+		return SpecError(error, where, "\"reorder\" is none, degree or rcm for a graph walk");
+	spec.reorder = reorder ? reorder->string : "none";
+	if (spec.reorder != "none" && spec.reorder != "degree" && spec.reorder != "rcm")
+		return SpecError(error, where, "\"reorder\" must be none, degree or rcm");
+	const JsonValue* start = value.Find("start");
+	if (start && (!IsInt(*start) || start->number < 0.0 || !onGraph))
+		return SpecError(error, where, "\"start\" is a vertex of the graph for a graph walk");
+	spec.start = start ? (long long)start->number : 0;
+	const JsonValue* goal = value.Find("target");
+	if (goal && (!IsInt(*goal) || goal->number < 0.0 || spec.walk != WALK_GRAPH_HITTING))
+		return SpecError(error, where, "\"target\" is a vertex of the graph for a graph_hitting walk");
+	if (spec.walk == WALK_GRAPH_HITTING && !goal)
+		return SpecError(error, where, "a graph_hitting walk needs a \"target\"");
+	spec.target = goal ? (long long)goal->number : spec.start;
+	spec.uncached = false;
+	return true;
+}
+
+static std::string ValueLabel(const JsonValue& value)
+{
+	char text[64];
+	if (value.type == JSON_STRING)
+		return value.string;
+	if (value.type == JSON_NUMBER)
+	{
+		snprintf(text, sizeof(text), "%g", value.number);
+		return text;
+	}
+	if (value.type == JSON_ARRAY)
+	{
+		std::string label;
+		for (size_t i = 0; i < value.items.size(); ++i)
+			label += (i ? "x" : "") + ValueLabel(value.items[i]);
+		return label;
+	}
+	return value.type == JSON_NULL ? "unbounded" : "?";
+}
+
+static void SetMember(JsonValue& object, const std::string& key, const JsonValue& value)
+{
+	for (size_t i = 0; i < object.keys.size(); ++i)
+	{
+		if (object.keys[i] == key)
+		{
+			object.items[i] = value;
+			return;
+		}
+	}
+	object.keys.push_back(key);
+	object.items.push_back(value);
+}
+
+static void RemoveMember(JsonValue& object, const std::string& key)
+{
+	for (size_t i = 0; i < object.keys.size(); ++i)
+	{
+		if (object.keys[i] == key)
+		{
+			object.keys.erase(object.keys.begin() + i);
+			object.items.erase(object.items.begin() + i);
+			return;
+		}
+	}
+}
+
+// An axis is a list of values, a single value, or a numeric range
+// { "from", "to", "step" } or { "from", "to", "factor" }.
+static bool ReadAxis(const JsonValue& axis, std::vector<JsonValue>& values)
+{
+	if (axis.type == JSON_ARRAY)
+		values = axis.items;
+	else if (axis.type == JSON_OBJECT)
+	{
+		const JsonValue* from = axis.Find("from");
+		const JsonValue* to = axis.Find("to");
+		const JsonValue* step = axis.Find("step");
+		const JsonValue* factor = axis.Find("factor");
+		if (!from || !to || from->type != JSON_NUMBER || to->type != JSON_NUMBER)
+			return false;
+		if (step && step->type == JSON_NUMBER && step->number > 0.0)
+		{
+			for (double v = from->number; v <= to->number + step->number * 1e-9; v += step->number)
+			{
+				values.push_back(JsonValue());
+				values.back().type = JSON_NUMBER;
+				values.back().number = v;
+			}
+		}
+		else if (factor && factor->type == JSON_NUMBER && factor->number > 1.0 && from->number > 0.0)
+		{
+			for (double v = from->number; v <= to->number * (1.0 + 1e-9); v *= factor->number)
+			{
+				values.push_back(JsonValue());
+				values.back().type = JSON_NUMBER;
+				values.back().number = v;
+			}
+		}
+		else
+			return false;
+	}
+	else
+		values.push_back(axis);
+	return !values.empty();
+}
+
+static bool ReadGrid(const JsonValue& value, const std::string& where, const std::string& fallbackName,
+	std::vector<ExperimentSpec>& specs, std::vector<ExperimentGrid>& grids, std::string& error)
+{
+	const JsonValue* grid = value.Find("grid");
+	if (grid->type != JSON_OBJECT)
+		return SpecError(error, where, "\"grid\" must be an object of axes");
+
+	const JsonValue* name = value.Find("name");
+	ExperimentGrid result;
+	result.name = name && name->type == JSON_STRING ? name->string : fallbackName;
+	if (!ReadOutputs(value.Find("output"), result.name, result.outputs))
+		return SpecError(error, where, "\"output\" must be a file name or a list of them");
+
+	std::vector<std::vector<JsonValue>> axes(grid->keys.size());
+	for (size_t a = 0; a < grid->keys.size(); ++a)
+	{
+		if (std::find(std::begin(GridAxes), std::end(GridAxes), grid->keys[a]) == std::end(GridAxes))
+			return SpecError(error, where, "cannot vary \"" + grid->keys[a] + "\" (walk, box, seed or trials)");
+		if (!ReadAxis(grid->items[a], axes[a]))
+			return SpecError(error, where, "bad values for grid axis \"" + grid->keys[a] + "\"");
+	}
+
+	JsonValue base = value;
+	RemoveMember(base, "grid");
+	RemoveMember(base, "output");
+	RemoveMember(base, "tree_output");
+	RemoveMember(base, "msd_output");
+	RemoveMember(base, "return_time_output");
+
+	//odometer over the axes, the last one changes fastest
+	std::vector<size_t> index(axes.size(), 0);
+	for (;;)
+	{
+		JsonValue cell = base;
+		JsonValue cellName;
+		cellName.type = JSON_STRING;
+		cellName.string = result.name;
+		for (size_t a = 0; a < axes.size(); ++a)
+		{
+			SetMember(cell, grid->keys[a], axes[a][index[a]]);
+			cellName.string += "/" + grid->keys[a] + "=" + ValueLabel(axes[a][index[a]]);
+		}
+		SetMember(cell, "name", cellName);
+
+		ExperimentSpec spec;
+		if (!ReadSpec(cell, where + " " + cellName.string, cellName.string, spec, error))
+			return false;
+		spec.outputs.clear();
+		result.cells.push_back((int)specs.size());
+		specs.push_back(spec);
+
+		size_t a = axes.size();
+		while (a > 0 && ++index[a - 1] == axes[a - 1].size())
+			index[--a] = 0;
+		if (a == 0)
+			break;
+	}
+
+	result.seed = specs[result.cells.front()].seed;
+	result.trials = specs[result.cells.front()].trials;
+	grids.push_back(result);
+	return true;
+}
+
+static bool ReadObject(const JsonValue& value, const std::string& where, const std::string& fallbackName,
+	std::vector<ExperimentSpec>& specs, std::vector<ExperimentGrid>& grids, std::string& error)
+{
+	if (value.type == JSON_OBJECT && value.Find("grid"))
+		return ReadGrid(value, where, fallbackName, specs, grids, error);
+
+	ExperimentSpec spec;
+	if (!ReadSpec(value, where, fallbackName, spec, error))
+		return false;
+	specs.push_back(spec);
+	return true;
+}
+
+bool LoadExperimentSpecs(const std::string& path, std::vector<ExperimentSpec>& specs,
+	std::vector<ExperimentGrid>& grids, std::string& error)
+{
+	JsonValue root;
+	if (!ReadJsonFile(path, root, error))
+		return false;
+
+	std::string stem = path.substr(path.find_last_of("/\\") + 1);
+	stem = stem.substr(0, stem.find('.'));
+
+	if (root.type != JSON_ARRAY)
+		return ReadObject(root, path, stem, specs, grids, error);
+
+	for (size_t i = 0; i < root.items.size(); ++i)
+	{
+		std::string index = std::to_string(i);
+		if (!ReadObject(root.items[i], path + " [" + index + "]", stem + "_" + index, specs, grids, error))
+			return false;
+	}
+	return true;
+}
+
+bool LoadExperimentGraphs(std::vector<ExperimentSpec>& specs, std::string& error)
+{
+	//a grid over seeds or trials walks the same graph in every cell
+	std::map<std::string, std::shared_ptr<const CsrGraph>> loaded;
+	for (size_t s = 0; s < specs.size(); ++s)
+	{
+		ExperimentSpec& spec = specs[s];
+		if (spec.graph.empty())
+			continue;
+
+		std::shared_ptr<const CsrGraph>& graph = loaded[spec.graph + "|" + spec.reorder];
+		if (!graph)
+		{
+			std::shared_ptr<CsrGraph> read(new CsrGraph());
+			if (!read->Load(spec.graph, error))
+				return false;
+			read->Reorder(spec.reorder == "degree" ? GRAPH_ORDER_DEGREE : spec.reorder == "rcm" ? GRAPH_ORDER_RCM : GRAPH_ORDER_FILE);
+			graph = read;
+		}
+		if (graph->Vertex(spec.start) < 0 || graph->Vertex(spec.target) < 0)
+		{
+			error = spec.name + ": " + spec.graph + " has vertices 0 to " + std::to_string(graph->Vertices() - 1);
+			return false;
+		}
+		spec.csr = graph;
+	}
+	return true;
+}
+
+RandomWalk MakeWalk(const ExperimentSpec& spec)
+{
+	RandomWalk rw;
+	rw.looperased = spec.walk == WALK_LOOP_ERASED;
+	rw.limit = spec.limit;
+	rw.limit_min = spec.limit_min;
+	rw.limit_max = spec.limit_max;
+	if (spec.walk == WALK_GAUSSIAN)
+		rw.kernel = KERNEL_GAUSSIAN;
+	else if (spec.walk == WALK_LEVY)
+		rw.kernel = KERNEL_LEVY;
+	rw.alpha = (float)spec.alpha;
+	rw.bias.Set(spec.weights, spec.pull);
+	rw.bias.SetMemory(spec.correlated, spec.persistence, spec.reversal);
+	rw.biased = !rw.bias.IsUniform();
+	return rw;
+}
+
+std::string DescribeBox(const RandomWalk& rw)
+{
+	if (!rw.limit)
+		return "unbounded";
+
+	char box[128];
+	snprintf(box, sizeof(box), "[%g,%g]x[%g,%g]x[%g,%g]",
+		rw.limit_min.x, rw.limit_max.x, rw.limit_min.y, rw.limit_max.y, rw.limit_min.z, rw.limit_max.z);
+	return box;
+}
+
+std::string DescribeBias(const RandomWalk& rw)
+{
+	if (!rw.biased)
+		return "uniform";
+
+	char bias[320];
+	const double* w = rw.bias.weights;
+	int length = snprintf(bias, sizeof(bias), "%.17g,%.17g,%.17g,%.17g,%.17g,%.17g pull=%.17g",
+		w[0], w[1], w[2], w[3], w[4], w[5], rw.bias.pull);
+	if (rw.bias.memory)
+		snprintf(bias + length, sizeof(bias) - length, " persistence=%.17g reversal=%.17g", rw.bias.persistence, rw.bias.reversal);
+	return bias;
+}
+
+void ExperimentColumns(WalkKind walk, std::vector<ResultColumn>& columns)
+{
+	columns.push_back({ "steps", COLUMN_INT64 });
+	if (walk == WALK_RETURN)
+		columns.push_back({ "probability", COLUMN_FLOAT64 });
+	else if (walk == WALK_EXIT_ERASED || walk == WALK_LAPLACIAN)
+	{
+		columns.push_back({ "ave_length", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_inner_length", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_SPANNING_TREE)
+	{
+		columns.push_back({ "ave_branch", COLUMN_FLOAT64 });
+		columns.push_back({ "leaf_fraction", COLUMN_FLOAT64 });
+		columns.push_back({ "branch_point_fraction", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_SHAPE)
+	{
+		columns.push_back({ "ave_gyration2", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_asphericity", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_span", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_max_displacement", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_SPHERES)
+	{
+		columns.push_back({ "hit_probability", COLUMN_FLOAT64 });
+		columns.push_back({ "exit_x_low", COLUMN_FLOAT64 });
+		columns.push_back({ "exit_x_high", COLUMN_FLOAT64 });
+		columns.push_back({ "exit_y_low", COLUMN_FLOAT64 });
+		columns.push_back({ "exit_y_high", COLUMN_FLOAT64 });
+		columns.push_back({ "exit_z_low", COLUMN_FLOAT64 });
+		columns.push_back({ "exit_z_high", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_spheres", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_GAUSSIAN || walk == WALK_LEVY)
+	{
+		columns.push_back({ "ave_dist", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_log_dist", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_GRAPH_RETURN)
+		columns.push_back({ "probability", COLUMN_FLOAT64 });
+	else if (walk == WALK_GRAPH_HITTING)
+	{
+		columns.push_back({ "hit_probability", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_capped_time", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_GRAPH_LOOP_ERASED)
+	{
+		columns.push_back({ "ave_length", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_largest", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_num_loop", COLUMN_FLOAT64 });
+	}
+	else if (walk == WALK_SAW)
+	{
+		columns.push_back({ "ave_end_to_end2", COLUMN_FLOAT64 });
+		columns.push_back({ "ave_gyration2", COLUMN_FLOAT64 });
+		columns.push_back({ "tau_int", COLUMN_FLOAT64 });
+	}
+	else
+	{
+		columns.push_back({ "ave_dist", COLUMN_FLOAT64 });
+		if (walk == WALK_NORMAL)
+			columns.push_back({ "ave_range", COLUMN_FLOAT64 });
+		if (walk == WALK_LOOP_ERASED)
+		{
+			columns.push_back({ "ave_largest", COLUMN_FLOAT64 });
+			columns.push_back({ "ave_num_loop", COLUMN_FLOAT64 });
+		}
+	}
+}
+
+static int ValueCount(WalkKind walk)
+{
+	if (walk == WALK_SPHERES)
+		return 8;
+	if (walk == WALK_SHAPE)
+		return 4;
+	if (walk == WALK_LOOP_ERASED || walk == WALK_SPANNING_TREE || walk == WALK_SAW || walk == WALK_GRAPH_LOOP_ERASED)
+		return 3;
+	return walk == WALK_NORMAL || walk == WALK_EXIT_ERASED || walk == WALK_LAPLACIAN
+		|| walk == WALK_GAUSSIAN || walk == WALK_LEVY || walk == WALK_GRAPH_HITTING ? 2 : 1;
+}
+
+// One distinct data point of a batch. Its trials run as chunks with their
+// own random streams, so the result does not depend on the order the pool
+// runs them.
+struct PointJob {
+	PointAccumulator acc;
+	int trials;
+	double target_error;
+	int max_trials;
+	std::string label;
+
+	std::mutex mutex;
+	int pending;
+	bool verbose;
+
+	std::vector<std::pair<int, int>> users;
+	PointCallback done;
+
+	ResultCache* cache;
+	std::string cacheKey;
+};
+
+// All horizons of a censored return spec from one set of walks to the last
+// horizon. Chunk k uses the stream chunk k of that horizon's own point
+// would, so the last point comes out the same either way.
+struct ReturnTimeJob {
+	int spec;
+	RandomWalk rw;
+	unsigned long long seed;
+	int chunk_trials;
+	std::vector<int> horizons;
+	ReturnTimes times;
+	std::vector<ExperimentPoint> points;
+	std::string label;
+
+	std::mutex mutex;
+	int pending;
+	bool verbose;
+	PointCallback done;
+};
+
+// Everything that decides the numbers of a chunk besides its index and size.
+static std::string CacheKey(const PointAccumulator& acc)
+{
+	//every field under its own label, also where it has its default, so no
+	//two settings can spell the same key; alpha only matters to a flight
+	static const char* kernels[] = { "lattice", "gaussian", "levy" };
+	char key[320];
+	snprintf(key, sizeof(key), "v%i lattice=cubic walk=%s box=%s steps=%i chunk=%i seed=%llu kernel=%s alpha=%.9g target=%.17g",
+		CACHE_VERSION, WalkKindNames[acc.walk], DescribeBox(acc.rw).c_str(), acc.steps, acc.chunk_trials, acc.seed,
+		kernels[acc.rw.kernel], acc.rw.kernel == KERNEL_LEVY ? acc.rw.alpha : 0.0, acc.target_radius);
+	std::string result = key;
+	result += " bias=" + DescribeBias(acc.rw);
+	if (acc.graph)
+	{
+		//renumbering keeps every neighbour list in order, the walks do not
+		//depend on it; a file rewired under the same name changes contents
+		char graph[160];
+		snprintf(graph, sizeof(graph), " vertices=%i edges=%lld contents=%016llx start=%i target=%i", acc.graph->Vertices(), acc.graph->Edges(),
+			(unsigned long long)acc.graph->contents, acc.graph->original[acc.start], acc.graph->original[acc.target]);
+		result += " graph=" + acc.graph_name + graph;
+	}
+	else
+		result += " graph=none";
+	return result;
+}
+
+// Rough relative cost of a point: loop erasure looks up every step in the
+// site index, which costs about as much again as the step itself.
+// The box walks take radius^2 steps, and the Laplacian one relaxes the whole
+// box, about a radius of sweeps, for each of its radius^1.62 steps. Wilson's
+// algorithm takes a few dozen steps per site of an n^3 box. A pivot attempt
+// costs about steps^0.11 lookups when rejected, and the accepted ones, a
+// fraction steps^-0.11 of them, move a third of the walk on average. A walk
+// on spheres takes some tens of jumps whatever its start. A flight step
+// takes a power on top of its three normals. An unbounded uniform return
+// walk jumps across cubes and costs about as much as 4 steps^0.35 steps, as
+// measured from 100 to 10000 steps. A graph step misses the cache
+// once on a large graph, and graph loop erasure looks up the path as well.
+static double EstimateCost(const PointJob* job)
+{
+	double steps = job->acc.steps;
+	double cost = steps * job->trials;
+	if (job->acc.walk == WALK_LOOP_ERASED)
+		cost *= 2.5;
+	else if (job->acc.walk == WALK_EXIT_ERASED)
+		cost *= steps;
+	else if (job->acc.walk == WALK_LAPLACIAN)
+		cost *= 40.0 * pow(steps, 4.62);
+	else if (job->acc.walk == WALK_SPANNING_TREE)
+		cost *= 30.0 * steps * steps;
+	else if (job->acc.walk == WALK_SAW)
+		cost = job->trials * (pow(steps, 0.11) + pow(steps, 0.89) / 3.0) + 20.0 * sqrt(steps) * steps;
+	else if (job->acc.walk == WALK_SPHERES)
+		cost = job->trials * 200.0;
+	else if (job->acc.walk == WALK_LEVY)
+		cost *= 2.0;
+	else if (job->acc.walk == WALK_RETURN && !job->acc.rw.biased && !job->acc.rw.limit)
+		cost = job->trials * 4.0 * pow(steps, 0.35);
+	else if (job->acc.walk == WALK_GRAPH_LOOP_ERASED)
+		cost *= 2.5;
+	return cost;
+}
+
+void InitAccumulator(PointAccumulator& acc, const RandomWalk& rw, WalkKind walk, int steps, int trials, unsigned long long seed)
+{
+	acc.rw = rw;
+	acc.walk = walk;
+	acc.steps = steps;
+	acc.seed = seed;
+	acc.chunk_trials = std::max(1, std::min(CHUNK_TRIALS, trials / 8));
+	//a pivot chunk is a whole chain with its own burn-in, keep them long
+	if (walk == WALK_SAW)
+		acc.chunk_trials = std::max(1, trials / 8);
+	acc.next_chunk = 0;
+	acc.chunks.clear();
+	acc.target_radius = 0.0;
+	acc.graph.reset();
+	acc.graph_name.clear();
+	acc.start = 0;
+	acc.target = 0;
+	acc.point.steps = steps;
+	acc.point.trials = 0;
+	for (int v = 0; v < POINT_VALUES; ++v)
+		acc.point.value[v] = 0.0;
+	acc.point.error = 0.0;
+}
+
+void SummarizePoint(PointAccumulator& acc)
+{
+	ExperimentPoint& point = acc.point;
+	point.steps = acc.steps;
+	point.trials = 0;
+	double sum[POINT_VALUES] = {};
+	for (size_t i = 0; i < acc.chunks.size(); ++i)
+	{
+		point.trials += acc.chunks[i].trials;
+		for (int v = 0; v < POINT_VALUES; ++v)
+			sum[v] += (double)acc.chunks[i].value[v] * acc.chunks[i].trials;
+	}
+	for (int v = 0; v < POINT_VALUES; ++v)
+		point.value[v] = point.trials ? sum[v] / point.trials : 0.0;
+
+	//batch means: a chunk of w trials has variance sigma^2 / w
+	point.error = 0.0;
+	if (acc.chunks.size() > 1)
+	{
+		double spread = 0.0;
+		for (size_t i = 0; i < acc.chunks.size(); ++i)
+		{
+			double d = acc.chunks[i].value[0] - point.value[0];
+			spread += acc.chunks[i].trials * d * d;
+		}
+		point.error = sqrt(spread / (acc.chunks.size() - 1) / point.trials);
+	}
+}
+
+// One walker per thread, its path and loop buffers stay allocated from job
+// to job.
+static RandomWalk& ThreadWalker(const RandomWalk& rw, unsigned long long seed)
+{
+	thread_local RandomWalk walker;
+	walker.limit = rw.limit;
+	walker.limit_min = rw.limit_min;
+	walker.limit_max = rw.limit_max;
+	walker.looperased = rw.looperased;
+	walker.biased = rw.biased;
+	walker.bias = rw.bias;
+	walker.loop.clear();
+	walker.rng.Seed(seed);
+	return walker;
+}
+
+static void ComputeChunk(const PointAccumulator& acc, ResultCache* cache, const std::string& cacheKey, int index, int trials, ChunkResult& chunk)
+{
+	TRACE_ZONE("Chunk");
+	chunk.index = index;
+	chunk.trials = trials;
+	if (cache && cache->Lookup(cacheKey, index, trials, chunk.value))
+		return;
+
+	for (int v = 0; v < POINT_VALUES; ++v)
+		chunk.value[v] = 0.f;
+	unsigned long long seed = MixSeed(MixSeed(MixSeed(acc.seed, acc.walk), acc.steps), index);
+	if (acc.walk == WALK_EXIT_ERASED || acc.walk == WALK_LAPLACIAN)
+	{
+		//keeps its site index while the radius stays the same
+		thread_local LaplacianWalk box;
+		box.rng.Seed(seed);
+		LaplacianTrials(box, acc.steps, trials, acc.walk == WALK_LAPLACIAN, chunk.value[0], chunk.value[1]);
+		if (cache)
+			cache->Store(cacheKey, index, trials, chunk.value);
+		return;
+	}
+	if (acc.walk == WALK_SPANNING_TREE)
+	{
+		thread_local SpanningTree tree;
+		tree.rng.Seed(seed);
+		TreeTrials(tree, acc.steps, trials, chunk.value[0], chunk.value[1], chunk.value[2]);
+		if (cache)
+			cache->Store(cacheKey, index, trials, chunk.value);
+		return;
+	}
+	if (acc.walk == WALK_SPHERES)
+	{
+		SphereDomain domain;
+		domain.Set(acc.rw.limit_min, acc.rw.limit_max, acc.target_radius);
+		Rng rng(seed);
+		float fractions[SPHERE_BOUNDARIES];
+		SphereTrials(rng, domain, glm::dvec3(acc.steps, 0.0, 0.0), trials, fractions, chunk.value[7]);
+		chunk.value[0] = fractions[SPHERE_TARGET];
+		for (int b = 0; b < 6; ++b)
+			chunk.value[1 + b] = fractions[b];
+		if (cache)
+			cache->Store(cacheKey, index, trials, chunk.value);
+		return;
+	}
+	if (acc.walk == WALK_GAUSSIAN || acc.walk == WALK_LEVY)
+	{
+		Rng rng(seed);
+		ContinuousTrials(rng, acc.rw, acc.steps, trials, chunk.value[0], chunk.value[1]);
+		if (cache)
+			cache->Store(cacheKey, index, trials, chunk.value);
+		return;
+	}
+	if (acc.graph)
+	{
+		Rng rng(seed);
+		if (acc.walk == WALK_GRAPH_LOOP_ERASED)
+			GraphLoopErasedTrials(*acc.graph, rng, acc.start, acc.steps, trials, chunk.value[0], chunk.value[1], chunk.value[2]);
+		else
+			GraphPassageTrials(*acc.graph, rng, acc.start, acc.target, acc.steps, trials, chunk.value[0], chunk.value[1]);
+		if (cache)
+			cache->Store(cacheKey, index, trials, chunk.value);
+		return;
+	}
+	if (acc.walk == WALK_SAW)
+	{
+		thread_local PivotWalk chain;
+		chain.rng.Seed(seed);
+		PivotTrials(chain, acc.steps, trials, chunk.value[0], chunk.value[1], chunk.value[2]);
+		if (cache)
+			cache->Store(cacheKey, index, trials, chunk.value);
+		return;
+	}
+
+	RandomWalk& walker = ThreadWalker(acc.rw, seed);
+	if (acc.walk == WALK_RETURN)
+		ReturnTrials(walker, acc.steps, trials, chunk.value[0]);
+	else if (acc.walk == WALK_LOOP_ERASED)
+		LoopErasedTrials(walker, acc.steps, trials, chunk.value[0], chunk.value[1], chunk.value[2]);
+	else if (acc.walk == WALK_SHAPE)
+		ShapeTrials(walker, acc.steps, trials, chunk.value[0], chunk.value[1], chunk.value[2], chunk.value[3]);
+	else
+		NormalTrials(walker, acc.steps, trials, chunk.value[0], chunk.value[1]);
+
+	if (cache)
+		cache->Store(cacheKey, index, trials, chunk.value);
+}
+
+bool RefinePoint(PointAccumulator& acc, int trials, ResultCache* cache, const std::atomic<bool>* cancel)
+{
+	if (cache && !cache->IsOpen())
+		cache = NULL;
+	std::string cacheKey = CacheKey(acc);
+
+	bool complete = true;
+	while (trials > 0)
+	{
+		if (cancel && *cancel)
+		{
+			complete = false;
+			break;
+		}
+		int size = std::min(trials, acc.chunk_trials);
+		ChunkResult chunk;
+		ComputeChunk(acc, cache, cacheKey, acc.next_chunk++, size, chunk);
+		acc.chunks.push_back(chunk);
+		trials -= size;
+	}
+	SummarizePoint(acc);
+	return complete;
+}
+
+bool MergeAccumulators(PointAccumulator& into, const PointAccumulator& from)
+{
+	if (CacheKey(into) != CacheKey(from))
+		return false;
+
+	for (size_t i = 0; i < from.chunks.size(); ++i)
+	{
+		bool found = false;
+		for (size_t j = 0; j < into.chunks.size() && !found; ++j)
+			found = into.chunks[j].index == from.chunks[i].index;
+		if (!found)
+			into.chunks.push_back(from.chunks[i]);
+	}
+	into.next_chunk = std::max(into.next_chunk, from.next_chunk);
+	SummarizePoint(into);
+	return true;
+}
+
+static void SubmitChunks(ThreadPool& pool, PointJob* job, int trials);
+
+// Called with the job mutex held once every submitted chunk is in.
+static void FinishRound(ThreadPool& pool, PointJob* job)
+{
+	SummarizePoint(job->acc);
+	const ExperimentPoint& point = job->acc.point;
+	if (job->target_error > 0.0 && point.error > job->target_error && point.trials < job->max_trials)
+	{
+		//error shrinks as 1/sqrt(trials), aim a little past the target
+		double ratio = point.error / job->target_error;
+		int more = (int)std::min(point.trials * (ratio * ratio * 1.1 - 1.0), (double)(job->max_trials - point.trials));
+		SubmitChunks(pool, job, std::max(more, job->acc.chunk_trials));
+		return;
+	}
+
+	if (job->verbose)
+		printf("%-24s steps=%-8i trials=%-8i value=%-12g error=%g\n",
+			job->label.c_str(), point.steps, point.trials, point.value[0], point.error);
+	if (job->done)
+	{
+		for (size_t i = 0; i < job->users.size(); ++i)
+			job->done(job->users[i].first, job->users[i].second, point);
+	}
+}
+
+static void RunChunk(ThreadPool& pool, PointJob* job, int slot, int index, int trials)
+{
+	ChunkResult chunk;
+	ComputeChunk(job->acc, job->cache, job->cacheKey, index, trials, chunk);
+
+	std::lock_guard<std::mutex> lock(job->mutex);
+	job->acc.chunks[slot] = chunk;
+	if (--job->pending == 0)
+		FinishRound(pool, job);
+}
+
+// Called with the job mutex held, or before any chunk of the job runs.
+static void SubmitChunks(ThreadPool& pool, PointJob* job, int trials)
+{
+	while (trials > 0)
+	{
+		int size = std::min(trials, job->acc.chunk_trials);
+		int index = job->acc.next_chunk++;
+		int slot = (int)job->acc.chunks.size();
+		job->acc.chunks.push_back(ChunkResult());
+		++job->pending;
+		trials -= size;
+		pool.Submit([&pool, job, slot, index, size] { RunChunk(pool, job, slot, index, size); });
+	}
+}
+
+// Log bins up to the last horizon, each horizon h also ending a bin at h + 1.
+static void ReturnTimeEdges(const std::vector<int>& horizons, std::vector<int>& edges)
+{
+	int last = *std::max_element(horizons.begin(), horizons.end());
+	edges.clear();
+	for (int b = 1; HistogramBinStart(b) <= last; ++b)
+		edges.push_back((int)HistogramBinStart(b));
+	for (size_t h = 0; h < horizons.size(); ++h)
+		edges.push_back(horizons[h] + 1);
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+// Called with the job mutex held once every chunk is in.
+static void FinishReturnTimes(ReturnTimeJob* job)
+{
+	const ReturnTimes& times = job->times;
+	job->points.resize(job->horizons.size());
+	for (size_t h = 0; h < job->horizons.size(); ++h)
+	{
+		long long returned = 0;
+		for (size_t i = 0; i + 1 < times.edges.size() && times.edges[i + 1] <= job->horizons[h] + 1; ++i)
+			returned += times.counts[i];
+
+		ExperimentPoint& point = job->points[h];
+		point.steps = job->horizons[h];
+		point.trials = times.trials;
+		for (int v = 0; v < POINT_VALUES; ++v)
+			point.value[v] = 0.0;
+		point.value[0] = (double)returned / times.trials;
+		//the walks are independent, binomial
+		point.error = sqrt(point.value[0] * (1.0 - point.value[0]) / times.trials);
+
+		if (job->verbose)
+			printf("%-24s steps=%-8i trials=%-8i value=%-12g error=%g\n",
+				job->label.c_str(), point.steps, point.trials, point.value[0], point.error);
+		if (job->done)
+			job->done(job->spec, (int)h, point);
+	}
+}
+
+static void RunReturnTimeChunk(ReturnTimeJob* job, int index, int trials)
+{
+	TRACE_ZONE("Chunk");
+	int steps = job->times.edges.back() - 1;
+	unsigned long long seed = MixSeed(MixSeed(MixSeed(job->seed, WALK_RETURN), steps), index);
+	std::vector<long long> counts;
+	ReturnTimeTrials(ThreadWalker(job->rw, seed), job->times.edges, trials, counts);
+
+	std::lock_guard<std::mutex> lock(job->mutex);
+	for (size_t i = 0; i < counts.size(); ++i)
+		job->times.counts[i] += counts[i];
+	if (--job->pending == 0)
+		FinishReturnTimes(job);
+}
+
+static void SubmitReturnTimes(ThreadPool& pool, ReturnTimeJob* job)
+{
+	int chunks = (job->times.trials + job->chunk_trials - 1) / job->chunk_trials;
+	job->pending = chunks;
+	for (int index = 0; index < chunks; ++index)
+	{
+		int size = std::min(job->chunk_trials, job->times.trials - index * job->chunk_trials);
+		pool.Submit([job, index, size] { RunReturnTimeChunk(job, index, size); });
+	}
+}
+
+int RunExperiments(const std::vector<ExperimentSpec>& specs, ThreadPool& pool,
+	std::vector<std::vector<ExperimentPoint>>& results, bool verbose, PointCallback done, ResultCache* cache,
+	std::vector<ReturnTimes>* returnTimes)
+{
+	std::vector<std::unique_ptr<PointJob>> jobs;
+	std::map<std::string, PointJob*> unique;
+	std::vector<std::vector<PointJob*>> specJobs(specs.size());
+
+	std::vector<std::unique_ptr<ReturnTimeJob>> returnJobs;
+	std::vector<ReturnTimeJob*> specReturnJob(specs.size(), NULL);
+	int censoredPoints = 0;
+
+	for (size_t s = 0; s < specs.size(); ++s)
+	{
+		const ExperimentSpec& spec = specs[s];
+		RandomWalk rw = MakeWalk(spec);
+		if (spec.censored)
+		{
+			returnJobs.push_back(std::unique_ptr<ReturnTimeJob>(new ReturnTimeJob()));
+			ReturnTimeJob* job = returnJobs.back().get();
+			job->spec = (int)s;
+			job->rw = rw;
+			job->seed = spec.seed;
+			job->chunk_trials = std::max(1, std::min(CHUNK_TRIALS, spec.trials / 8));
+			job->horizons = spec.horizons;
+			ReturnTimeEdges(spec.horizons, job->times.edges);
+			job->times.counts.assign(job->times.edges.size() - 1, 0);
+			job->times.trials = spec.trials;
+			job->label = spec.name;
+			job->verbose = verbose;
+			job->done = done;
+			specReturnJob[s] = job;
+			censoredPoints += (int)spec.horizons.size();
+			continue;
+		}
+		if (!spec.graph.empty() && !spec.csr)
+		{
+			fprintf(stderr, "Error : %s: graph %s is not loaded\n", spec.name.c_str(), spec.graph.c_str());
+			continue;
+		}
+		for (size_t h = 0; h < spec.horizons.size(); ++h)
+		{
+			char key[1024];
+			snprintf(key, sizeof(key), "%s|%s|%i|%i|%.17g|%i|%llu|%.17g|%.17g|%s|%s|%s|%lld|%lld", WalkKindNames[spec.walk], DescribeBox(rw).c_str(),
+				spec.horizons[h], spec.trials, spec.target_error, spec.max_trials, spec.seed, spec.target_radius, spec.alpha,
+				DescribeBias(rw).c_str(), spec.graph.c_str(), spec.reorder.c_str(), spec.start, spec.target);
+
+			PointJob*& job = unique[key];
+			if (!job)
+			{
+				jobs.push_back(std::unique_ptr<PointJob>(new PointJob()));
+				job = jobs.back().get();
+				InitAccumulator(job->acc, rw, spec.walk, spec.horizons[h], spec.trials, spec.seed);
+				job->acc.target_radius = spec.target_radius;
+				if (spec.csr)
+				{
+					job->acc.graph = spec.csr;
+					job->acc.graph_name = spec.graph;
+					job->acc.start = spec.csr->Vertex(spec.start);
+					job->acc.target = spec.csr->Vertex(spec.target);
+				}
+				job->trials = spec.trials;
+				job->pending = 0;
+				job->cache = cache && cache->IsOpen() && !spec.uncached ? cache : NULL;
+				job->cacheKey = CacheKey(job->acc);
+				job->target_error = spec.target_error;
+				job->max_trials = spec.max_trials;
+				job->label = spec.name;
+				job->verbose = verbose;
+				job->done = done;
+			}
+			job->users.push_back(std::make_pair((int)s, (int)h));
+			specJobs[s].push_back(job);
+		}
+	}
+
+	//walks to the last horizon, as long as anything in their spec
+	for (size_t i = 0; i < returnJobs.size(); ++i)
+	{
+		std::lock_guard<std::mutex> lock(returnJobs[i]->mutex);
+		SubmitReturnTimes(pool, returnJobs[i].get());
+	}
+
+	//most expensive first so the last chunks to finish are short ones
+	std::vector<PointJob*> order;
+	for (size_t i = 0; i < jobs.size(); ++i)
+		order.push_back(jobs[i].get());
+	std::stable_sort(order.begin(), order.end(), [](const PointJob* a, const PointJob* b) { return EstimateCost(a) > EstimateCost(b); });
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		std::lock_guard<std::mutex> lock(order[i]->mutex);
+		SubmitChunks(pool, order[i], order[i]->trials);
+	}
+	pool.Wait();
+
+	results.assign(specs.size(), std::vector<ExperimentPoint>());
+	if (returnTimes)
+		returnTimes->assign(specs.size(), ReturnTimes());
+	for (size_t s = 0; s < specs.size(); ++s)
+	{
+		for (size_t h = 0; h < specJobs[s].size(); ++h)
+			results[s].push_back(specJobs[s][h]->acc.point);
+		if (specReturnJob[s])
+		{
+			results[s] = specReturnJob[s]->points;
+			if (returnTimes)
+				(*returnTimes)[s] = specReturnJob[s]->times;
+		}
+	}
+	return (int)jobs.size() + censoredPoints;
+}
+
+bool WriteExperiment(const ExperimentSpec& spec, const std::vector<ExperimentPoint>& points,
+	std::chrono::steady_clock::time_point start)
+{
+	std::vector<ResultColumn> columns;
+	ExperimentColumns(spec.walk, columns);
+	int values = ValueCount(spec.walk);
+	columns.push_back({ "trials", COLUMN_INT64 });
+	columns.push_back({ "stderr", COLUMN_FLOAT64 });
+
+	RandomWalk rw = MakeWalk(spec);
+	RunMetadata meta;
+	meta.experiment = spec.name;
+	meta.lattice = CUBIC_LATTICE;
+	meta.box = DescribeBox(rw);
+	meta.seed = spec.seed;
+	meta.trials = spec.trials;
+	if (spec.walk == WALK_LEVY)
+	{
+		char alpha[32];
+		snprintf(alpha, sizeof(alpha), "%g", spec.alpha);
+		meta.extra.push_back(std::make_pair("alpha", std::string(alpha)));
+	}
+	if (rw.biased)
+		meta.extra.push_back(std::make_pair("steps", DescribeBias(rw)));
+	if (spec.csr)
+	{
+		meta.lattice = "graph";
+		meta.box = "not used";
+		meta.extra.push_back(std::make_pair("graph", spec.graph));
+		meta.extra.push_back(std::make_pair("reorder", spec.reorder));
+		meta.extra.push_back(std::make_pair("vertices", std::to_string(spec.csr->Vertices())));
+		meta.extra.push_back(std::make_pair("edges", std::to_string(spec.csr->Edges())));
+	}
+
+	bool ok = true;
+	for (size_t o = 0; o < spec.outputs.size(); ++o)
+	{
+		ResultSink* sink = CreateResultSink(spec.outputs[o]);
+		if (!sink->Open(spec.outputs[o], columns, meta))
+		{
+			fprintf(stderr, "Error : cannot write %s\n", spec.outputs[o].c_str());
+			delete sink;
+			ok = false;
+			continue;
+		}
+		sink->SetStart(start);
+
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			double row[POINT_VALUES + 3];
+			row[0] = points[i].steps;
+			for (int v = 0; v < values; ++v)
+				row[1 + v] = points[i].value[v];
+			row[1 + values] = points[i].trials;
+			row[2 + values] = points[i].error;
+			sink->Append(row);
+		}
+		sink->Close();
+		delete sink;
+	}
+	return ok;
+}
+
+bool WriteSpanningTree(const ExperimentSpec& spec)
+{
+	SpanningTree tree;
+	int n = spec.horizons.back();
+	tree.rng.Seed(MixSeed(MixSeed(MixSeed(spec.seed, WALK_SPANNING_TREE), n), ~0ull));
+	tree.SetBox(n, n, n);
+	tree.Sample();
+	return tree.Write(spec.tree_output);
+}
+
+bool WriteWalkMsd(const ExperimentSpec& spec, ThreadPool* pool)
+{
+	RandomWalk rw = MakeWalk(spec);
+	int n = spec.horizons.back();
+	rw.rng.Seed(MixSeed(MixSeed(MixSeed(spec.seed, WALK_NORMAL), n), ~0ull));
+	std::vector<unsigned char> directions;
+	WalkDirections(rw, n, directions);
+
+	TrajectoryStats stats;
+	AnalyzeTrajectory(directions, pool, stats);
+
+	RunMetadata meta;
+	meta.experiment = spec.name;
+	meta.lattice = CUBIC_LATTICE;
+	meta.box = DescribeBox(rw);
+	meta.seed = spec.seed;
+	meta.trials = 1;
+	return WriteTrajectoryStats(spec.msd_output, stats, meta);
+}
+
+bool WriteReturnTimes(const ExperimentSpec& spec, const ReturnTimes& times, std::chrono::steady_clock::time_point start)
+{
+	std::vector<ResultColumn> columns;
+	columns.push_back({ "bin_start", COLUMN_INT64 });
+	columns.push_back({ "bin_end", COLUMN_INT64 });
+	columns.push_back({ "first_returns", COLUMN_INT64 });
+	columns.push_back({ "returned", COLUMN_FLOAT64 });
+
+	long long returned = 0;
+	for (size_t i = 0; i < times.counts.size(); ++i)
+		returned += times.counts[i];
+
+	RunMetadata meta;
+	meta.experiment = spec.name;
+	meta.lattice = CUBIC_LATTICE;
+	meta.box = DescribeBox(MakeWalk(spec));
+	meta.seed = spec.seed;
+	meta.trials = times.trials;
+	meta.extra.push_back(std::make_pair("censored", std::to_string(times.trials - returned)));
+
+	ResultSink* sink = CreateResultSink(spec.return_time_output);
+	if (!sink->Open(spec.return_time_output, columns, meta))
+	{
+		delete sink;
+		return false;
+	}
+	sink->SetStart(start);
+
+	long long cumulative = 0;
+	for (size_t i = 0; i < times.counts.size(); ++i)
+	{
+		cumulative += times.counts[i];
+		double row[4] = { (double)times.edges[i], (double)times.edges[i + 1], (double)times.counts[i], (double)cumulative / times.trials };
+		sink->Append(row);
+	}
+	sink->Close();
+	delete sink;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////// GRID
+
+GridWriter::~GridWriter()
+{
+	Close();
+}
+
+bool GridWriter::Open(const ExperimentGrid& grid, std::chrono::steady_clock::time_point start)
+{
+	std::vector<ResultColumn> columns;
+	columns.push_back({ "walk", COLUMN_INT64 });
+	columns.push_back({ "box_x", COLUMN_FLOAT64 });
+	columns.push_back({ "box_y", COLUMN_FLOAT64 });
+	columns.push_back({ "box_z", COLUMN_FLOAT64 });
+	columns.push_back({ "seed", COLUMN_INT64 });
+	columns.push_back({ "steps", COLUMN_INT64 });
+	columns.push_back({ "trials", COLUMN_INT64 });
+	columns.push_back({ "mean", COLUMN_FLOAT64 });
+	columns.push_back({ "stderr", COLUMN_FLOAT64 });
+	columns.push_back({ "ave_largest", COLUMN_FLOAT64 });
+	columns.push_back({ "ave_num_loop", COLUMN_FLOAT64 });
+	columns.push_back({ "ave_range", COLUMN_FLOAT64 });
+
+	std::string walks;
+	for (int w = 0; w < WALK_KIND_COUNT; ++w)
+		walks += (w ? ", " : "") + std::to_string(w) + " " + WalkKindNames[w];
+
+	RunMetadata meta;
+	meta.experiment = grid.name;
+	meta.lattice = CUBIC_LATTICE;
+	meta.box = "per row, 0 is unbounded";
+	meta.seed = grid.seed;
+	meta.trials = grid.trials;
+	meta.extra.push_back(std::make_pair("walk_codes", walks));
+	meta.extra.push_back(std::make_pair("cells", std::to_string(grid.cells.size())));
+	meta.extra.push_back(std::make_pair("mean", "ave_dist, probability for return and graph_return, ave_length for exit_erased, laplacian and graph_loop_erased, ave_branch for spanning_tree, ave_end_to_end2 for saw, ave_gyration2 for shape, hit_probability for walk_on_spheres and graph_hitting"));
+
+	bool ok = true;
+	for (size_t o = 0; o < grid.outputs.size(); ++o)
+	{
+		ResultSink* sink = CreateResultSink(grid.outputs[o]);
+		if (!sink->Open(grid.outputs[o], columns, meta))
+		{
+			fprintf(stderr, "Error : cannot write %s\n", grid.outputs[o].c_str());
+			delete sink;
+			ok = false;
+			continue;
+		}
+		sink->SetStart(start);
+		sinks.push_back(sink);
+	}
+	lastFlush = std::chrono::steady_clock::now();
+	return ok;
+}
+
+void GridWriter::Append(const ExperimentSpec& cell, const ExperimentPoint& point)
+{
+	double row[12];
+	row[0] = cell.walk;
+	for (int i = 0; i < 3; ++i)
+		row[1 + i] = cell.limit ? cell.limit_max[i] - cell.limit_min[i] : 0.0;
+	row[4] = (double)cell.seed;
+	row[5] = point.steps;
+	row[6] = point.trials;
+	row[7] = point.value[0];
+	row[8] = point.error;
+	bool loops = cell.walk == WALK_LOOP_ERASED || cell.walk == WALK_GRAPH_LOOP_ERASED;
+	row[9] = loops ? point.value[1] : NAN;
+	row[10] = loops ? point.value[2] : NAN;
+	row[11] = cell.walk == WALK_NORMAL ? point.value[1] : NAN;
+
+	//at most one flush a second keeps the files current without turning
+	//every cell into its own record batch
+	std::lock_guard<std::mutex> lock(mutex);
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	bool flush = now - lastFlush > std::chrono::seconds(1);
+	for (size_t i = 0; i < sinks.size(); ++i)
+	{
+		sinks[i]->Append(row);
+		if (flush)
+			sinks[i]->Flush();
+	}
+	if (flush)
+		lastFlush = now;
+}
+
+void GridWriter::Close()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (size_t i = 0; i < sinks.size(); ++i)
+	{
+		sinks[i]->Close();
+		delete sinks[i];
+	}
+	sinks.clear();
+}
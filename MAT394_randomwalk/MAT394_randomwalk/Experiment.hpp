@@ -0,0 +1,228 @@
+/* Start Header -------------------------------------------------------
+File Name: Experiment.hpp
+Purpose: Experiment specification files and the batch experiment runner
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef EXPERIMENT_HPP
+#define EXPERIMENT_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <glm/glm.hpp>
+
+#include "RandomWalk.hpp"
+#include "ResultSink.hpp"
+#include "ResultCache.hpp"
+#include "GraphWalk.hpp"
+
+#define CUBIC_LATTICE "cubic Z^3, nearest neighbour"
+
+class ThreadPool;
+
+enum WalkKind {
+	WALK_NORMAL,
+	WALK_LOOP_ERASED,
+	WALK_RETURN,
+	WALK_EXIT_ERASED,
+	WALK_LAPLACIAN,
+	WALK_SPANNING_TREE,
+	WALK_SAW,
+	WALK_SHAPE,
+	WALK_SPHERES,
+	WALK_GAUSSIAN,
+	WALK_LEVY,
+	WALK_GRAPH_RETURN,
+	WALK_GRAPH_HITTING,
+	WALK_GRAPH_LOOP_ERASED,
+	WALK_KIND_COUNT
+};
+
+extern const char* WalkKindNames[WALK_KIND_COUNT];
+
+// One entry of a spec file. Example:
+//	{ "name": "lerw_box100", "walk": "loop_erased", "box": 100,
+//	  "horizons": { "from": 10, "to": 10000, "factor": 10 },
+//	  "trials": 1000, "target_error": 0.05, "max_trials": 100000,
+//	  "seed": 7, "output": ["lerw_box100.arrow", "lerw_box100.csv"] }
+// A file holds one such object or an array of them. An object with a
+// "grid" expands into the cartesian product of the listed values, e.g.
+//	"grid": { "walk": ["normal", "loop_erased"], "box": { "from": 10, "to": 200, "step": 10 } }
+// and all of its cells stream into the one output of the grid.
+// A horizon is a number of steps for most walks. What it means for the
+// others, and the keys only some walks take, is noted where ReadSpec reads
+// them in Experiment.cpp.
+struct ExperimentSpec {
+	std::string name;
+	WalkKind walk;
+	std::string lattice;
+	int dimension;
+	bool limit;
+	glm::vec3 limit_min;
+	glm::vec3 limit_max;
+	std::vector<int> horizons;
+	int trials;
+	double target_error;
+	int max_trials;
+	unsigned long long seed;
+	std::vector<std::string> outputs;
+	std::string tree_output;
+	std::string msd_output;
+	bool censored;
+	std::string return_time_output;
+	double target_radius;
+	//levy only
+	double alpha;
+	//uniform steps unless set
+	double weights[6];
+	double pull;
+	bool correlated;
+	double persistence;
+	double reversal;
+	//graph walks only; vertices are numbered as in the file
+	std::string graph;
+	std::string reorder;
+	long long start;
+	long long target;
+	std::shared_ptr<const CsrGraph> csr;
+	//set by the caller, never read from a file: every chunk is computed,
+	//for what the walks record on the side
+	bool uncached;
+};
+
+// First-return times of a censored return spec: counts[i] walks came back
+// at a step in [edges[i], edges[i+1]), the other ones were still out after
+// edges.back() - 1 steps. The edges are the log bins of HistogramBin, split
+// after every horizon.
+struct ReturnTimes {
+	std::vector<int> edges;
+	std::vector<long long> counts;
+	int trials;
+};
+
+// value[] holds the simulation outputs in column order, error the standard
+// error of value[0] estimated from the spread of the trial chunks.
+struct ExperimentPoint {
+	int steps;
+	int trials;
+	double value[POINT_VALUES];
+	double error;
+};
+
+// cells index the spec list; the cells themselves have no outputs.
+struct ExperimentGrid {
+	std::string name;
+	std::vector<std::string> outputs;
+	std::vector<int> cells;
+	unsigned long long seed;
+	int trials;
+};
+
+bool LoadExperimentSpecs(const std::string& path, std::vector<ExperimentSpec>& specs,
+	std::vector<ExperimentGrid>& grids, std::string& error);
+
+// Loads the graph of every graph spec, each file and order once.
+bool LoadExperimentGraphs(std::vector<ExperimentSpec>& specs, std::string& error);
+
+RandomWalk MakeWalk(const ExperimentSpec& spec);
+std::string DescribeBox(const RandomWalk& rw);
+std::string DescribeBias(const RandomWalk& rw);
+void ExperimentColumns(WalkKind walk, std::vector<ResultColumn>& columns);
+
+// Called from the pool threads as soon as a data point is final.
+typedef std::function<void(int spec, int horizon, const ExperimentPoint& point)> PointCallback;
+
+// Splits every (spec, horizon) point into trial chunks on the pool. Points
+// that several specs ask for with the same walk, box, trials and seed run
+// once and are shared. The most expensive points are queued first so the
+// cheap ones fill the tail. A censored spec is one set of walks for all of
+// its horizons, not cached; its distribution goes to returnTimes[spec] if
+// given. Returns the number of distinct points computed.
+int RunExperiments(const std::vector<ExperimentSpec>& specs, ThreadPool& pool,
+	std::vector<std::vector<ExperimentPoint>>& results, bool verbose, PointCallback done = PointCallback(),
+	ResultCache* cache = NULL, std::vector<ReturnTimes>* returnTimes = NULL);
+
+struct ChunkResult {
+	int index;
+	int trials;
+	float value[POINT_VALUES];
+};
+
+// Mergeable state of one data point: the chunks run so far and the index
+// of the next one, which is also the cursor into the point's random
+// streams. Chunk k always uses the same stream, so a point refined in
+// steps ends up exactly where a single run with all the trials would.
+struct PointAccumulator {
+	RandomWalk rw;
+	WalkKind walk;
+	int steps;
+	unsigned long long seed;
+	int chunk_trials;
+	int next_chunk;
+	std::vector<ChunkResult> chunks;
+	ExperimentPoint point;
+	//walk_on_spheres only, 0 by default
+	double target_radius;
+	//graph walks only, the vertices renumbered as in graph
+	std::shared_ptr<const CsrGraph> graph;
+	std::string graph_name;
+	int start;
+	int target;
+};
+
+// trials only sets the chunk size, nothing runs until RefinePoint.
+void InitAccumulator(PointAccumulator& acc, const RandomWalk& rw, WalkKind walk, int steps, int trials, unsigned long long seed);
+
+// Runs trials more trials on the calling thread, chunked and seeded like
+// RunExperiments so both share cache entries. Returns false if cancelled;
+// the chunks finished before that are kept.
+bool RefinePoint(PointAccumulator& acc, int trials, ResultCache* cache, const std::atomic<bool>* cancel);
+
+// Adds the chunks of from that into does not have yet. Both must describe
+// the same configuration.
+bool MergeAccumulators(PointAccumulator& into, const PointAccumulator& from);
+void SummarizePoint(PointAccumulator& acc);
+
+bool WriteExperiment(const ExperimentSpec& spec, const std::vector<ExperimentPoint>& points,
+	std::chrono::steady_clock::time_point start);
+
+// Samples the extra tree of spec and writes it to spec.tree_output.
+bool WriteSpanningTree(const ExperimentSpec& spec);
+
+// Walks the extra walk of spec and writes its lag statistics to
+// spec.msd_output; pool may be NULL.
+bool WriteWalkMsd(const ExperimentSpec& spec, ThreadPool* pool);
+
+// bin_start, bin_end, first_returns and returned, the fraction of the walks
+// back by bin_end - 1, to spec.return_time_output; start as for
+// WriteExperiment.
+bool WriteReturnTimes(const ExperimentSpec& spec, const ReturnTimes& times, std::chrono::steady_clock::time_point start);
+
+// Rows of every walk kind share one table: walk is the index into
+// WalkKindNames, box sizes are 0 when unbounded and columns a walk does not
+// produce are NaN. Rows come in completion order as cells finish.
+class GridWriter {
+public:
+	~GridWriter();
+
+	bool Open(const ExperimentGrid& grid, std::chrono::steady_clock::time_point start);
+	void Append(const ExperimentSpec& cell, const ExperimentPoint& point);
+	void Close();
+
+private:
+	std::vector<ResultSink*> sinks;
+	std::mutex mutex;
+	std::chrono::steady_clock::time_point lastFlush;
+};
+
+#endif
@@ -0,0 +1,165 @@
+/* Start Header -------------------------------------------------------
+File Name: FastForward.cpp
+Purpose: Exact multi-step jumps of a walk across an empty lattice cube
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <algorithm>
+#include <mutex>
+
+#include "FastForward.hpp"
+#include "Trace.hpp"
+
+static const int Perm[6][3] = {
+	{ 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+};
+
+// Evolves the walk over the inside of the cube. What steps onto the face
+// x = radius is recorded for every step; the six faces carry the same, so
+// that face stands for all of them.
+void CubeJumpTable::Build(int r)
+{
+	TRACE_ZONE("CubeJumpTable::Build");
+	radius = r;
+	horizon = r * r;
+	entries.clear();
+	cdf.clear();
+
+	int w = 2 * r + 1;
+	auto Index = [r, w](int x, int y, int z) { return ((x + r) * w + (y + r)) * w + (z + r); };
+	std::vector<double> cur(w * w * w, 0.0);
+	std::vector<double> next(w * w * w);
+	cur[Index(0, 0, 0)] = 1.0;
+
+	//(a, b) with r > a >= b >= 0, a face site up to the symmetries of the face
+	std::vector<double> face(r * r);
+	double total = 0.0;
+	for (int t = 1; t <= horizon; ++t)
+	{
+		std::fill(next.begin(), next.end(), 0.0);
+		for (int x = -r + 1; x < r; ++x)
+		{
+			for (int y = -r + 1; y < r; ++y)
+			{
+				for (int z = -r + 1; z < r; ++z)
+				{
+					int i = Index(x, y, z);
+					double m = cur[i];
+					if (m == 0.0)
+						continue;
+					m *= 1.0 / 6.0;
+					next[i - w * w] += m;
+					next[i + w * w] += m;
+					next[i - w] += m;
+					next[i + w] += m;
+					next[i - 1] += m;
+					next[i + 1] += m;
+				}
+			}
+		}
+
+		std::fill(face.begin(), face.end(), 0.0);
+		for (int u = -r + 1; u < r; ++u)
+		{
+			for (int v = -r + 1; v < r; ++v)
+			{
+				int a = std::max(abs(u), abs(v));
+				int b = std::min(abs(u), abs(v));
+				face[a * r + b] += 6.0 * next[Index(r, u, v)];
+			}
+		}
+		for (int a = 0; a < r; ++a)
+		{
+			for (int b = 0; b <= a; ++b)
+			{
+				if (face[a * r + b] == 0.0)
+					continue;
+				total += face[a * r + b];
+				entries.push_back({ t, (short)a, (short)b, 0, 1 });
+				cdf.push_back(total);
+			}
+		}
+
+		//the faces are never read from, what is on them is gone
+		std::swap(cur, next);
+	}
+
+	//still inside: (a, b, c) with r > a >= b >= c >= 0
+	std::vector<double> inside(r * r * r, 0.0);
+	for (int x = -r + 1; x < r; ++x)
+	{
+		for (int y = -r + 1; y < r; ++y)
+		{
+			for (int z = -r + 1; z < r; ++z)
+			{
+				int s[3] = { abs(x), abs(y), abs(z) };
+				std::sort(s, s + 3);
+				inside[(s[2] * r + s[1]) * r + s[0]] += cur[Index(x, y, z)];
+			}
+		}
+	}
+	for (int a = 0; a < r; ++a)
+	{
+		for (int b = 0; b <= a; ++b)
+		{
+			for (int c = 0; c <= b; ++c)
+			{
+				double m = inside[(a * r + b) * r + c];
+				if (m == 0.0)
+					continue;
+				total += m;
+				entries.push_back({ horizon, (short)a, (short)b, (short)c, 0 });
+				cdf.push_back(total);
+			}
+		}
+	}
+}
+
+bool CubeJumpTable::Sample(Rng& rng, int& time, glm::ivec3& offset) const
+{
+	double u = rng.Uniform() * cdf.back();
+	size_t i = std::min((size_t)(std::upper_bound(cdf.begin(), cdf.end(), u) - cdf.begin()), cdf.size() - 1);
+	const CubeJump& e = entries[i];
+	time = e.time;
+
+	unsigned bits = (unsigned)rng.Next();
+	if (e.exit)
+	{
+		//a random face, then a random symmetry of the face
+		int a = e.a;
+		int b = e.b;
+		if (bits & 1)
+			std::swap(a, b);
+		if (bits & 2)
+			a = -a;
+		if (bits & 4)
+			b = -b;
+		int face = rng.Below(6);
+		int axis = face % 3;
+		offset[axis] = face < 3 ? radius : -radius;
+		offset[(axis + 1) % 3] = a;
+		offset[(axis + 2) % 3] = b;
+		return true;
+	}
+
+	//a random signed permutation
+	const int* p = Perm[rng.Below(6)];
+	int v[3] = { e.a, e.b, e.c };
+	for (int k = 0; k < 3; ++k)
+		offset[p[k]] = (bits >> k) & 1 ? -v[k] : v[k];
+	return false;
+}
+
+static CubeJumpTable tables[CUBE_LEVELS + 1];
+static std::once_flag built[CUBE_LEVELS + 1];
+
+const CubeJumpTable& CubeJumps(int level)
+{
+	std::call_once(built[level], [level]() { tables[level].Build(1 << level); });
+	return tables[level];
+}
@@ -0,0 +1,64 @@
+/* Start Header -------------------------------------------------------
+File Name: FastForward.hpp
+Purpose: Exact multi-step jumps of a walk across an empty lattice cube
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef FASTFORWARD_HPP
+#define FASTFORWARD_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+
+//cubes of radius 2, 4, ..., 2^CUBE_LEVELS
+#define CUBE_LEVELS 5
+
+// A walk started at the centre of the cube |x|_inf <= radius either leaves
+// it, stepping onto a face, within horizon = radius^2 steps, or is still
+// inside after them. The table holds the exact distribution of both
+// outcomes, when and where, from the probabilities evolved step by step
+// over the cube, so one draw replaces up to horizon steps. Only one
+// representative of every orbit under the symmetries of the cube is kept;
+// a random symmetry spreads it back out.
+struct CubeJump {
+	int time;
+	short a, b, c;
+	short exit;
+};
+
+class CubeJumpTable {
+public:
+	void Build(int radius);
+
+	// time and the offset from the centre; true if the walk left the cube,
+	// which then happened at step time and not before.
+	bool Sample(Rng& rng, int& time, glm::ivec3& offset) const;
+
+	int radius;
+	int horizon;
+
+private:
+	std::vector<CubeJump> entries;
+	std::vector<double> cdf;
+};
+
+// Built the first time a level is asked for, then shared by every thread.
+const CubeJumpTable& CubeJumps(int level);
+
+// Largest level whose cube fits in room, 0 if none does.
+inline int CubeLevel(int room)
+{
+	int level = 0;
+	while (level < CUBE_LEVELS && (2 << level) <= room)
+		++level;
+	return level;
+}
+
+#endif
@@ -0,0 +1,173 @@
+/* Start Header -------------------------------------------------------
+File Name: FrameProfiler.cpp
+Purpose: Per-pass frame timing and the Frame Profiler window
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <string.h>
+#include <float.h>
+#include <chrono>
+
+// Include GLEW
+#include <GL/glew.h>
+
+#include "FrameProfiler.hpp"
+#include "imgui/imgui.h"
+
+const char* PassNames[PASS_COUNT] = {
+	"Simulation",
+	"Axes",
+	"Path",
+	"Loop",
+	"Head",
+	"ImGui"
+};
+
+static double NowMs()
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FrameProfiler::FrameProfiler()
+{
+	m_gpuTimers = false;
+	m_frame = 0;
+	memset(m_cpu, 0, sizeof(m_cpu));
+	memset(m_gpu, 0, sizeof(m_gpu));
+	memset(m_gpuValid, 0, sizeof(m_gpuValid));
+	memset(m_queries, 0, sizeof(m_queries));
+	memset(m_issued, 0, sizeof(m_issued));
+	memset(m_cpuStart, 0, sizeof(m_cpuStart));
+}
+
+void FrameProfiler::Init()
+{
+	//timer queries are core since 3.3, so Mesa llvmpipe has them as well
+	m_gpuTimers = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+	if (m_gpuTimers)
+		glGenQueries(2 * PASS_COUNT, &m_queries[0][0]);
+}
+
+void FrameProfiler::Clear()
+{
+	if (m_gpuTimers)
+		glDeleteQueries(2 * PASS_COUNT, &m_queries[0][0]);
+	m_gpuTimers = false;
+}
+
+void FrameProfiler::BeginFrame()
+{
+	int buffer = m_frame & 1;
+	for (int p = 0; p < PASS_COUNT; ++p)
+	{
+		m_cpu[p][m_frame % PROFILER_HISTORY] = 0.f;
+		m_gpu[p][m_frame % PROFILER_HISTORY] = 0.f;
+		//a pass that is not drawn takes no time
+		m_gpuValid[p][m_frame % PROFILER_HISTORY] = true;
+
+		//this buffer was issued two frames ago; skip it rather than stall
+		if (!m_gpuTimers || !m_issued[buffer][p])
+			continue;
+
+		GLuint available = 0;
+		glGetQueryObjectuiv(m_queries[buffer][p], GL_QUERY_RESULT_AVAILABLE, &available);
+		int slot = (m_frame - 2 + PROFILER_HISTORY) % PROFILER_HISTORY;
+		if (available)
+		{
+			GLuint64 ns = 0;
+			glGetQueryObjectui64v(m_queries[buffer][p], GL_QUERY_RESULT, &ns);
+			m_gpu[p][slot] = (float)(ns * 1e-6);
+		}
+		else
+			m_gpuValid[p][slot] = false;
+		m_issued[buffer][p] = 0;
+	}
+}
+
+void FrameProfiler::EndFrame()
+{
+	++m_frame;
+}
+
+void FrameProfiler::BeginPass(FramePass pass)
+{
+	m_cpuStart[pass] = NowMs();
+	if (m_gpuTimers)
+		glBeginQuery(GL_TIME_ELAPSED, m_queries[m_frame & 1][pass]);
+}
+
+void FrameProfiler::EndPass(FramePass pass)
+{
+	if (m_gpuTimers)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_issued[m_frame & 1][pass] = 1;
+	}
+	m_cpu[pass][m_frame % PROFILER_HISTORY] += (float)(NowMs() - m_cpuStart[pass]);
+}
+
+// Averages skip the current frame and, for the GPU, the two in flight and
+// the ones whose result came too late.
+float FrameProfiler::CpuAverage(FramePass pass) const
+{
+	int count = m_frame < PROFILER_HISTORY ? m_frame : PROFILER_HISTORY - 1;
+	float sum = 0.f;
+	for (int i = 1; i <= count; ++i)
+		sum += m_cpu[pass][(m_frame - i + PROFILER_HISTORY) % PROFILER_HISTORY];
+	return count ? sum / count : 0.f;
+}
+
+float FrameProfiler::GpuAverage(FramePass pass) const
+{
+	int frames = m_frame - 1 < PROFILER_HISTORY - 2 ? m_frame - 1 : PROFILER_HISTORY - 2;
+	int count = 0;
+	float sum = 0.f;
+	for (int i = 2; i <= frames + 1; ++i)
+	{
+		int slot = (m_frame - i + PROFILER_HISTORY) % PROFILER_HISTORY;
+		if (m_gpuValid[pass][slot])
+		{
+			sum += m_gpu[pass][slot];
+			++count;
+		}
+	}
+	return count > 0 ? sum / count : 0.f;
+}
+
+void FrameProfiler::Draw()
+{
+	ImGui::Begin("Frame Profiler");
+	if (!m_gpuTimers)
+		ImGui::Text("GPU timer queries are not supported, CPU times only");
+
+	ImGui::Text("PASS            CPU ms      GPU ms");
+	float cpuTotal = 0.f, gpuTotal = 0.f;
+	for (int p = 0; p < PASS_COUNT; ++p)
+	{
+		FramePass pass = (FramePass)p;
+		ImGui::Text("%-12s %9.3f   %9.3f", PassNames[p], CpuAverage(pass), GpuAverage(pass));
+		cpuTotal += CpuAverage(pass);
+		gpuTotal += GpuAverage(pass);
+	}
+	ImGui::Text("%-12s %9.3f   %9.3f", "Total", cpuTotal, gpuTotal);
+
+	//the path is drawn one segment per draw call, so it usually wins first
+	float path = CpuAverage(PASS_PATH) > GpuAverage(PASS_PATH) ? CpuAverage(PASS_PATH) : GpuAverage(PASS_PATH);
+	if (path > CpuAverage(PASS_SIMULATION))
+		ImGui::Text("Path rendering limits autoplay speed");
+	else
+		ImGui::Text("Simulation limits autoplay speed");
+
+	ImGui::NewLine();
+	int offset = (m_frame + 1) % PROFILER_HISTORY;
+	for (int p = 0; p < PASS_COUNT; ++p)
+	{
+		const float* values = m_gpuTimers && p != PASS_SIMULATION ? m_gpu[p] : m_cpu[p];
+		ImGui::PlotLines(PassNames[p], values, PROFILER_HISTORY, offset, NULL, 0.f, FLT_MAX, ImVec2(0, 40));
+	}
+	ImGui::End();
+}
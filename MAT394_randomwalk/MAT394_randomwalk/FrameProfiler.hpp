@@ -0,0 +1,61 @@
+/* Start Header -------------------------------------------------------
+File Name: FrameProfiler.hpp
+Purpose: GPU timer-query and CPU timing of the render passes
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef FRAMEPROFILER_HPP
+#define FRAMEPROFILER_HPP
+
+#define PROFILER_HISTORY 120
+
+enum FramePass {
+	PASS_SIMULATION,
+	PASS_AXES,
+	PASS_PATH,
+	PASS_LOOP,
+	PASS_HEAD,
+	PASS_IMGUI,
+	PASS_COUNT
+};
+
+// Each pass owns two GL_TIME_ELAPSED queries and alternates between them
+// every frame, so a result is read two frames after it was issued and the
+// CPU never waits on the GPU. A result not in by then is dropped and its
+// frame left out of the GPU average. Without timer queries only CPU times
+// are kept.
+class FrameProfiler {
+public:
+	FrameProfiler();
+	void Init();
+	void Clear();
+
+	void BeginFrame();
+	void EndFrame();
+	void BeginPass(FramePass pass);
+	void EndPass(FramePass pass);
+
+	float CpuAverage(FramePass pass) const;
+	float GpuAverage(FramePass pass) const;
+	void Draw();
+
+	bool m_gpuTimers;
+	int m_frame;
+	float m_cpu[PASS_COUNT][PROFILER_HISTORY];
+	float m_gpu[PASS_COUNT][PROFILER_HISTORY];
+	bool m_gpuValid[PASS_COUNT][PROFILER_HISTORY];
+
+private:
+	GLuint m_queries[2][PASS_COUNT];
+	int m_issued[2][PASS_COUNT];
+	double m_cpuStart[PASS_COUNT];
+};
+
+extern const char* PassNames[PASS_COUNT];
+
+#endif
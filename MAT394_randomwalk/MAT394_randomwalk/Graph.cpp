@@ -1,7 +1,7 @@
 
 /* Start Header -------------------------------------------------------
 File Name: Graph.cpp
-Purpose: Random Walk Simulation, Drawing axes and graphs.
+Purpose: Drawing axes and graphs.
 Language: C++
 Platform: MSVC2019 window
 Project: Random Walk Simulation
@@ -15,8 +15,6 @@ End Header --------------------------------------------------------*/
 
 #include <string>
 #include <cstring>
-#include <stdlib.h> 
-#include <time.h>   
 
 
 // Include GLEW
@@ -126,109 +124,6 @@ void Line::Clear()
 	glDeleteVertexArrays(1, &m_VertexArray);
 }
 
-void RandomWalk::Walk()
-{
-	glm::vec3 laststep = points.back();
-	bool done = false;
-
-	while (!done)
-	{
-		int newdirection = rand() % 6;
-		switch (newdirection)
-		{
-		case Direction::X_UP:
-			++laststep.x;
-			break;
-		case Direction::Y_UP:
-			++laststep.y;
-			break;
-		case Direction::Z_UP:
-			++laststep.z;
-			break;
-		case Direction::X_DOWN:
-			--laststep.x;
-			break;
-		case Direction::Y_DOWN:
-			--laststep.y;
-			break;
-		case Direction::Z_DOWN:
-			--laststep.z;
-			break;
-		}
-
-		if (!limit)
-			done = true;
-		else
-		{
-			if (laststep.x > limit_max.x || laststep.y > limit_max.y || laststep.z > limit_max.z
-				|| laststep.x < limit_min.x || laststep.y < limit_min.y || laststep.z < limit_min.z)
-			{
-				laststep = points.back();
-			}
-			else
-				done = true;
-
-		}
-
-	}
-
-	++steps;
-	points.push_back(laststep);
-
-}
-
-void RandomWalk::RemoveLast()
-{
-	if (steps == 0)
-		return;
-
-	points.pop_back();
-	--steps;
-
-}
-
-float RandomWalk::Distance()
-{
-	return glm::distance(startPosition, points.back());
-}
-
-void RandomWalk::Reset()
-{
-	points.clear();
-	points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-	points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-	startPosition = points.front();
-	steps = 0;
-	num_loop = 0;
-	size_loop = 0;
-	biggest_loop = 0;
-	loop_exist = false;
-
-
-}
-
-void RandomWalk::CheckLoop()
-{
-	std::vector<glm::vec3>::iterator samepoint = std::find(points.begin()+1, points.end(), points.back());
-	if (samepoint == --points.end())
-	{
-		loop_exist = false;
-		loop.clear();
-	}
-	else
-	{
-		loop_exist = true;
-		std::copy(samepoint, points.end(), std::back_inserter(loop));
-		points.erase(samepoint, --points.end());
-
-		size_loop = (int)loop.size()-1;
-		if (biggest_loop < size_loop)
-			biggest_loop = size_loop;
-		
-	}
-
-}
-
 Sphere::Sphere()
 {
 	scale = glm::vec3(1.f, 1.f, 1.f);
@@ -321,77 +216,3 @@ void Sphere::Draw(GLuint shader, glm::vec3 ViewPos)
 	glBindVertexArray(0);
 	glUseProgram(0);
 }
-
-void NormalSimulation(int steps, RandomWalk rw, float& distance)
-{
-	float sum = 0;
-	RandomWalk copy = rw;
-	for (int i = 0; i < TRIALS; ++i)
-	{
-		copy.Reset();
-		for (int j = 0; j < steps; ++j)
-		{
-			copy.Walk();
-
-		}
-
-		sum += copy.Distance();
-
-	}
-
-	distance = sum / (float)TRIALS;
-}
-
-void LoopErasedSimulation(int steps, RandomWalk rw, float& distance, float& largest_loop, float& erased_loop)
-{
-	int largetest_loop_sum = 0;
-	int erased_loop_sum = 0;
-	float sum = 0;
-	RandomWalk copy = rw;
-	for (int i = 0; i < TRIALS; ++i)
-	{
-		copy.Reset();
-		for (int j = 0; j < steps; ++j)
-		{
-			copy.Walk();
-			copy.CheckLoop();
-			if (copy.loop_exist)
-				++copy.num_loop;
-
-		}
-
-		sum += copy.Distance();
-		largetest_loop_sum += copy.biggest_loop;
-		erased_loop_sum += copy.num_loop;
-	}
-
-	distance = sum / (float)TRIALS;
-	largest_loop = (float)largetest_loop_sum / (float)TRIALS;
-	erased_loop = (float)erased_loop_sum / (float)TRIALS;
-
-}
-
-void ProbabilityToReturn(RandomWalk rw, float& prob, int steps)
-{
-	int num_return = 0;
-
-	RandomWalk copy = rw;
-	for (int i = 0; i < TRIALS; ++i)
-	{
-		copy.Reset();
-		for (int j = 0; j < steps; ++j)
-		{
-			copy.Walk();
-			if (copy.points.back() == glm::vec3(0, 0, 0))
-			{
-				++num_return;
-				break;
-			}
-
-		}
-	}
-
-	prob = (float)num_return / (float) TRIALS;
-
-
-}
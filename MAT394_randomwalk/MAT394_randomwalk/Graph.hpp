@@ -1,7 +1,7 @@
 
 /* Start Header -------------------------------------------------------
 File Name: Graph.hpp
-Purpose: Random walk class, sphere, axes
+Purpose: Sphere, axes and path lines
 Language: C++
 Platform: MSVC2019 window
 Project: Random Walk Simulation
@@ -13,7 +13,7 @@ End Header --------------------------------------------------------*/
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
-#define TRIALS 1000
+#include "RandomWalk.hpp"
 
 enum LineType {
 	X,
@@ -73,63 +73,4 @@ private:
 
 };
 
-enum Direction {
-	X_UP,
-	Y_UP,
-	Z_UP,
-	X_DOWN,
-	Y_DOWN,
-	Z_DOWN
-};
-
-class RandomWalk {
-
-public:
-	RandomWalk() {
-		points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-		points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-		startPosition = points.front();
-		steps = 0;
-		looperased = false;
-		num_loop = 0;
-		size_loop = 0;
-		biggest_loop = 0;
-		loop_exist = false;
-		
-		limit = false;
-		limit_min = glm::vec3(-200, -200, -200);
-		limit_max = glm::vec3(200, 200, 200);
-	}
-
-	void Walk();
-	void RemoveLast();
-	float Distance();
-	void Reset();
-	void CheckLoop();
-
-	
-	std::vector<glm::vec3> points;
-	int steps;
-	glm::vec3 startPosition;
-	glm::vec3 limit_min;
-	glm::vec3 limit_max;
-	bool limit;
-
-	//loop erased rw
-	bool looperased;
-	int num_loop;
-	int size_loop;
-	int biggest_loop;
-	bool loop_exist;
-	std::vector<glm::vec3> loop;
-	
-
-};
-
-
-void NormalSimulation(int steps, RandomWalk rw, float& distance);
-void LoopErasedSimulation(int steps, RandomWalk rw, float& distance,float& largetst_loop, float& erased_loop);
-void ProbabilityToReturn(RandomWalk rw, float& prob, int steps);
-
-
 #endif
\ No newline at end of file
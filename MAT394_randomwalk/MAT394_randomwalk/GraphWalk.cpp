@@ -0,0 +1,363 @@
+/* Start Header -------------------------------------------------------
+File Name: GraphWalk.cpp
+Purpose: Random walks on sparse graphs loaded from edge lists
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <algorithm>
+#include <numeric>
+
+#include "GraphWalk.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+//text is read this much at a time; no line may be longer
+#define GRAPH_READ_BUFFER (1 << 24)
+
+static bool ReadNumber(const char*& c, const char* end, uint32_t& number)
+{
+	while (c < end && (*c == ' ' || *c == '\t' || *c == ','))
+		++c;
+	if (c == end || *c < '0' || *c > '9')
+		return false;
+	long long value = 0;
+	while (c < end && *c >= '0' && *c <= '9')
+	{
+		value = value * 10 + (*c++ - '0');
+		if (value >= INT_MAX)
+			return false;
+	}
+	number = (uint32_t)value;
+	return true;
+}
+
+// Whole lines of buffer[0, size); returns where the unfinished last one
+// starts.
+static size_t ReadLines(const char* buffer, size_t size, bool last, long long& line,
+	std::vector<uint32_t>& ends, std::string& error)
+{
+	const char* c = buffer;
+	const char* end = buffer + size;
+	for (;;)
+	{
+		const char* stop = (const char*)memchr(c, '\n', end - c);
+		if (!stop)
+		{
+			if (!last || c == end)
+				return c - buffer;
+			stop = end;
+		}
+		++line;
+
+		const char* p = c;
+		while (p < stop && (*p == ' ' || *p == '\t' || *p == '\r'))
+			++p;
+		if (p < stop && *p != '#' && *p != '%')
+		{
+			uint32_t u, v;
+			if (!ReadNumber(p, stop, u) || !ReadNumber(p, stop, v))
+			{
+				error = "line " + std::to_string(line) + " is not an edge";
+				return std::string::npos;
+			}
+			ends.push_back(u);
+			ends.push_back(v);
+		}
+		if (stop == end)
+			return size;
+		c = stop + 1;
+	}
+}
+
+bool CsrGraph::Load(const std::string& path, std::string& error)
+{
+	TRACE_ZONE("CsrGraph::Load");
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+	{
+		error = "cannot open " + path;
+		return false;
+	}
+
+	std::vector<uint32_t> ends;
+	std::vector<char> buffer(GRAPH_READ_BUFFER);
+	size_t kept = fread(buffer.data(), 1, 4, file);
+	bool ok = true;
+	if (kept == 4 && memcmp(buffer.data(), "RWG1", 4) == 0)
+	{
+		//pairs of numbers to the end of the file
+		std::vector<uint32_t> block(GRAPH_READ_BUFFER / sizeof(uint32_t));
+		size_t got;
+		while ((got = fread(block.data(), sizeof(uint32_t), block.size(), file)) > 0)
+			ends.insert(ends.end(), block.begin(), block.begin() + got);
+		for (size_t i = 0; i < ends.size() && ok; ++i)
+			ok = ends[i] < INT_MAX;
+		if (!ok || ends.size() % 2)
+		{
+			error = path + " is not a list of uint32 pairs";
+			ok = false;
+		}
+	}
+	else
+	{
+		long long line = 0;
+		for (;;)
+		{
+			size_t got = fread(buffer.data() + kept, 1, buffer.size() - kept, file);
+			size_t size = kept + got;
+			size_t done = ReadLines(buffer.data(), size, got == 0, line, ends, error);
+			if (done == std::string::npos)
+			{
+				error = path + ": " + error;
+				ok = false;
+				break;
+			}
+			if (got == 0)
+				break;
+			if (done == 0 && size == buffer.size())
+			{
+				error = path + ": line " + std::to_string(line + 1) + " is too long";
+				ok = false;
+				break;
+			}
+			kept = size - done;
+			memmove(buffer.data(), buffer.data() + done, kept);
+		}
+	}
+	fclose(file);
+	if (!ok)
+		return false;
+	if (ends.empty())
+	{
+		error = path + " has no edges";
+		return false;
+	}
+
+	Build(ends);
+	return true;
+}
+
+void CsrGraph::Build(std::vector<uint32_t>& ends)
+{
+	TRACE_ZONE("CsrGraph::Build");
+	uint32_t largest = 0;
+	for (size_t i = 0; i < ends.size(); ++i)
+		largest = std::max(largest, ends[i]);
+	int vertices = ends.empty() ? 0 : (int)largest + 1;
+
+	//counting sort of both ends of every edge by vertex
+	offsets.assign(vertices + 1, 0);
+	for (size_t i = 0; i < ends.size(); ++i)
+		++offsets[ends[i] + 1];
+	for (int v = 0; v < vertices; ++v)
+		offsets[v + 1] += offsets[v];
+	neighbours.resize(ends.size());
+	std::vector<long long> next(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i + 1 < ends.size(); i += 2)
+	{
+		neighbours[next[ends[i]]++] = (int)ends[i + 1];
+		neighbours[next[ends[i + 1]]++] = (int)ends[i];
+	}
+	std::vector<uint32_t>().swap(ends);
+
+	contents = MixSeed(0, (uint64_t)vertices);
+	for (size_t e = 0; e < neighbours.size(); ++e)
+		contents = MixSeed(contents, (uint64_t)neighbours[e]);
+
+	original.resize(vertices);
+	std::iota(original.begin(), original.end(), 0);
+	index = original;
+}
+
+// Breadth first from a vertex of least degree in every component, the
+// neighbours of a vertex numbered by increasing degree, then the whole
+// numbering reversed.
+static void CuthillMcKee(const CsrGraph& graph, std::vector<int>& order)
+{
+	int n = graph.Vertices();
+	std::vector<int> byDegree(n);
+	std::iota(byDegree.begin(), byDegree.end(), 0);
+	std::stable_sort(byDegree.begin(), byDegree.end(), [&graph](int a, int b) { return graph.Degree(a) < graph.Degree(b); });
+
+	std::vector<char> seen(n, 0);
+	std::vector<int> next;
+	order.clear();
+	order.reserve(n);
+	for (int i = 0; i < n; ++i)
+	{
+		int root = byDegree[i];
+		if (seen[root])
+			continue;
+		seen[root] = 1;
+		size_t head = order.size();
+		order.push_back(root);
+		while (head < order.size())
+		{
+			int v = order[head++];
+			next.clear();
+			for (long long e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e)
+			{
+				int w = graph.neighbours[e];
+				if (!seen[w])
+				{
+					seen[w] = 1;
+					next.push_back(w);
+				}
+			}
+			std::sort(next.begin(), next.end(), [&graph](int a, int b) { return graph.Degree(a) < graph.Degree(b); });
+			order.insert(order.end(), next.begin(), next.end());
+		}
+	}
+	std::reverse(order.begin(), order.end());
+}
+
+void CsrGraph::Reorder(GraphOrder order)
+{
+	if (order == GRAPH_ORDER_FILE)
+		return;
+	TRACE_ZONE("CsrGraph::Reorder");
+
+	//the vertex that gets each new number
+	int n = Vertices();
+	std::vector<int> from(n);
+	if (order == GRAPH_ORDER_DEGREE)
+	{
+		std::iota(from.begin(), from.end(), 0);
+		std::stable_sort(from.begin(), from.end(), [this](int a, int b) { return Degree(a) > Degree(b); });
+	}
+	else
+		CuthillMcKee(*this, from);
+
+	std::vector<int> renumber(n);
+	for (int k = 0; k < n; ++k)
+		renumber[from[k]] = k;
+
+	std::vector<long long> newOffsets(n + 1, 0);
+	std::vector<int> newNeighbours(neighbours.size());
+	for (int k = 0; k < n; ++k)
+	{
+		long long first = offsets[from[k]];
+		long long degree = offsets[from[k] + 1] - first;
+		newOffsets[k + 1] = newOffsets[k] + degree;
+		for (long long e = 0; e < degree; ++e)
+			newNeighbours[newOffsets[k] + e] = renumber[neighbours[first + e]];
+	}
+	offsets.swap(newOffsets);
+	neighbours.swap(newNeighbours);
+
+	std::vector<int> newOriginal(n);
+	for (int k = 0; k < n; ++k)
+		newOriginal[k] = original[from[k]];
+	original.swap(newOriginal);
+	for (int k = 0; k < n; ++k)
+		index[original[k]] = k;
+}
+
+void GraphPassageTrials(const CsrGraph& graph, Rng& rng, int start, int target, int steps, int trials, float& hit, float& time)
+{
+	TRACE_ZONE("GraphPassageTrials");
+	StatBusy busy;
+	long long hits = 0;
+	long long time_sum = 0;
+	long long walked = 0;
+	int at[GRAPH_BLOCK];
+	for (int first = 0; first < trials; first += GRAPH_BLOCK)
+	{
+		//the walkers still going are at[0, active)
+		int active = std::min(GRAPH_BLOCK, trials - first);
+		for (int i = 0; i < active; ++i)
+			at[i] = start;
+		for (int t = 1; t <= steps && active; ++t)
+		{
+			walked += active;
+			for (int i = 0; i < active;)
+			{
+				if (graph.Degree(at[i]) == 0)
+				{
+					time_sum += steps;
+					at[i] = at[--active];
+					continue;
+				}
+				int v = graph.Neighbour(rng, at[i]);
+				if (v == target)
+				{
+					++hits;
+					time_sum += t;
+					at[i] = at[--active];
+					continue;
+				}
+				at[i++] = v;
+			}
+		}
+		time_sum += (long long)active * steps;
+		StatAdd(STAT_TRIALS, std::min(GRAPH_BLOCK, trials - first));
+	}
+	StatAdd(STAT_STEPS, walked);
+
+	hit = (float)hits / trials;
+	time = (float)((double)time_sum / trials);
+}
+
+void GraphLoopErasedTrials(const CsrGraph& graph, Rng& rng, int start, int steps, int trials,
+	float& length, float& largest_loop, float& erased_loop)
+{
+	TRACE_ZONE("GraphLoopErasedTrials");
+	StatBusy busy;
+	//index on the path of every vertex, -1 off it; left all -1 after a trial
+	thread_local std::vector<int> position;
+	thread_local std::vector<int> path;
+	if ((int)position.size() < graph.Vertices())
+		position.assign(graph.Vertices(), -1);
+
+	long long length_sum = 0;
+	long long largest_sum = 0;
+	long long loop_sum = 0;
+	long long walked = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		path.clear();
+		path.push_back(start);
+		position[start] = 0;
+		int largest = 0;
+		int s = 0;
+		for (; s < steps && graph.Degree(path.back()) > 0; ++s)
+		{
+			int v = graph.Neighbour(rng, path.back());
+			int found = position[v];
+			if (found < 0)
+			{
+				position[v] = (int)path.size();
+				path.push_back(v);
+				continue;
+			}
+
+			//the walk is back at path[found]: the loop after it goes
+			int loop = (int)path.size() - found;
+			largest = std::max(largest, loop);
+			++loop_sum;
+			StatAdd(STAT_LOOPS_ERASED);
+			for (size_t k = found + 1; k < path.size(); ++k)
+				position[path[k]] = -1;
+			path.resize(found + 1);
+		}
+		walked += s;
+
+		length_sum += (long long)path.size() - 1;
+		largest_sum += largest;
+		for (size_t k = 0; k < path.size(); ++k)
+			position[path[k]] = -1;
+		StatAdd(STAT_TRIALS);
+	}
+	StatAdd(STAT_STEPS, walked);
+
+	length = (float)((double)length_sum / trials);
+	largest_loop = (float)((double)largest_sum / trials);
+	erased_loop = (float)((double)loop_sum / trials);
+}
@@ -0,0 +1,90 @@
+/* Start Header -------------------------------------------------------
+File Name: GraphWalk.hpp
+Purpose: Random walks on sparse graphs loaded from edge lists
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef GRAPHWALK_HPP
+#define GRAPHWALK_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Random.hpp"
+
+//walkers a first-passage chunk steps side by side
+#define GRAPH_BLOCK 64
+
+enum GraphOrder {
+	GRAPH_ORDER_FILE,
+	GRAPH_ORDER_DEGREE,
+	GRAPH_ORDER_RCM
+};
+
+// An undirected graph in compressed sparse rows: the neighbours of vertex
+// v are neighbours[offsets[v]] to neighbours[offsets[v + 1] - 1]. Every
+// edge is stored at both ends, and repeated edges and self-loops are kept,
+// so a walk picks each edge at its vertex with equal probability.
+// Vertices can be renumbered for locality, by decreasing degree so the
+// hubs share cache lines, or by reverse Cuthill-McKee so neighbours get
+// nearby numbers; original maps the new numbers back to the file's.
+class CsrGraph {
+public:
+	// A binary file is "RWG1" followed by the edges as pairs of uint32
+	// vertex numbers. Anything else is read as text, one edge "u v" per
+	// line; further columns and lines starting with # or % are skipped.
+	// Vertices are numbered from 0 to the largest number in the file.
+	bool Load(const std::string& path, std::string& error);
+
+	// ends holds the edges as pairs of vertex numbers; it is used up.
+	void Build(std::vector<uint32_t>& ends);
+	void Reorder(GraphOrder order);
+
+	int Vertices() const { return (int)offsets.size() - 1; }
+	long long Edges() const { return (long long)neighbours.size() / 2; }
+
+	// New number of a vertex of the file, -1 if there is no such vertex.
+	int Vertex(long long number) const
+	{
+		return number >= 0 && number < (long long)index.size() ? index[(size_t)number] : -1;
+	}
+
+	int Degree(int v) const { return (int)(offsets[v + 1] - offsets[v]); }
+
+	int Neighbour(Rng& rng, int v) const
+	{
+		long long first = offsets[v];
+		return neighbours[first + rng.Below((unsigned)(offsets[v + 1] - first))];
+	}
+
+	std::vector<long long> offsets;
+	std::vector<int> neighbours;
+	std::vector<int> original;
+	std::vector<int> index;
+	//hash of the neighbour lists in the numbering of the file, which is
+	//what the walks depend on; Reorder leaves it as it is
+	uint64_t contents;
+};
+
+// Walks from start until they reach target, at step 1 or later, or have
+// taken steps steps; a walk that reaches a vertex without edges stops
+// there. hit is the fraction that reached target, time the average of the
+// first passage time capped at steps. start == target gives returns. The
+// walkers of a block step together, so the neighbour lookups of different
+// walkers, which miss the cache on a large graph, overlap.
+void GraphPassageTrials(const CsrGraph& graph, Rng& rng, int start, int target, int steps, int trials, float& hit, float& time);
+
+// Loop-erased walks of steps steps from start, as LoopErasedTrials on the
+// lattice: length is the average number of edges left on the path,
+// largest_loop the average largest erased loop, erased_loop the average
+// number of erased loops.
+void GraphLoopErasedTrials(const CsrGraph& graph, Rng& rng, int start, int steps, int trials,
+	float& length, float& largest_loop, float& erased_loop);
+
+#endif
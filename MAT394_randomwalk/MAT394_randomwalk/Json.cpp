@@ -0,0 +1,256 @@
+/* Start Header -------------------------------------------------------
+File Name: Json.cpp
+Purpose: Recursive descent JSON reader
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include "Json.hpp"
+
+const JsonValue* JsonValue::Find(const std::string& key) const
+{
+	for (size_t i = 0; i < keys.size(); ++i)
+		if (keys[i] == key)
+			return &items[i];
+	return NULL;
+}
+
+struct JsonParser {
+	const std::string& text;
+	size_t pos;
+	std::string error;
+
+	JsonParser(const std::string& _text) : text(_text), pos(0) {}
+
+	bool Fail(const char* message)
+	{
+		if (error.empty())
+		{
+			int line = 1;
+			for (size_t i = 0; i < pos && i < text.size(); ++i)
+				if (text[i] == '\n')
+					++line;
+			error = "line " + std::to_string(line) + ": " + message;
+		}
+		return false;
+	}
+
+	void SkipSpace()
+	{
+		while (pos < text.size())
+		{
+			char c = text[pos];
+			if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+				++pos;
+			else if (c == '/' && pos + 1 < text.size() && text[pos + 1] == '/')
+			{
+				while (pos < text.size() && text[pos] != '\n')
+					++pos;
+			}
+			else
+				break;
+		}
+	}
+
+	bool Literal(const char* word)
+	{
+		size_t length = strlen(word);
+		if (text.compare(pos, length, word) != 0)
+			return Fail("unexpected token");
+		pos += length;
+		return true;
+	}
+
+	bool String(std::string& out)
+	{
+		++pos;
+		while (pos < text.size() && text[pos] != '"')
+		{
+			char c = text[pos++];
+			if (c != '\\')
+			{
+				out += c;
+				continue;
+			}
+			if (pos >= text.size())
+				break;
+			c = text[pos++];
+			switch (c)
+			{
+			case 'n': out += '\n'; break;
+			case 't': out += '\t'; break;
+			case 'r': out += '\r'; break;
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'u':
+			{
+				//spec files are ASCII, anything else becomes '?'
+				if (pos + 4 > text.size())
+					return Fail("bad escape");
+				long code = strtol(text.substr(pos, 4).c_str(), NULL, 16);
+				out += code < 128 ? (char)code : '?';
+				pos += 4;
+				break;
+			}
+			default: out += c; break;
+			}
+		}
+		if (pos >= text.size())
+			return Fail("unterminated string");
+		++pos;
+		return true;
+	}
+
+	bool Value(JsonValue& value)
+	{
+		SkipSpace();
+		if (pos >= text.size())
+			return Fail("unexpected end of file");
+
+		char c = text[pos];
+		if (c == '{')
+		{
+			value.type = JSON_OBJECT;
+			++pos;
+			SkipSpace();
+			if (pos < text.size() && text[pos] == '}')
+			{
+				++pos;
+				return true;
+			}
+			for (;;)
+			{
+				SkipSpace();
+				if (pos >= text.size() || text[pos] != '"')
+					return Fail("expected a key");
+				std::string key;
+				if (!String(key))
+					return false;
+				SkipSpace();
+				if (pos >= text.size() || text[pos] != ':')
+					return Fail("expected ':'");
+				++pos;
+				value.keys.push_back(key);
+				value.items.push_back(JsonValue());
+				if (!Value(value.items.back()))
+					return false;
+				SkipSpace();
+				if (pos < text.size() && text[pos] == ',')
+					++pos;
+				else if (pos < text.size() && text[pos] == '}')
+				{
+					++pos;
+					return true;
+				}
+				else
+					return Fail("expected ',' or '}'");
+			}
+		}
+		if (c == '[')
+		{
+			value.type = JSON_ARRAY;
+			++pos;
+			SkipSpace();
+			if (pos < text.size() && text[pos] == ']')
+			{
+				++pos;
+				return true;
+			}
+			for (;;)
+			{
+				value.items.push_back(JsonValue());
+				if (!Value(value.items.back()))
+					return false;
+				SkipSpace();
+				if (pos < text.size() && text[pos] == ',')
+					++pos;
+				else if (pos < text.size() && text[pos] == ']')
+				{
+					++pos;
+					return true;
+				}
+				else
+					return Fail("expected ',' or ']'");
+			}
+		}
+		if (c == '"')
+		{
+			value.type = JSON_STRING;
+			return String(value.string);
+		}
+		if (c == 't' || c == 'f')
+		{
+			value.type = JSON_BOOL;
+			value.boolean = c == 't';
+			return Literal(c == 't' ? "true" : "false");
+		}
+		if (c == 'n')
+		{
+			value.type = JSON_NULL;
+			return Literal("null");
+		}
+
+		//strtod also takes inf, nan and hex, which JSON does not have, and an
+		//out of range number comes back infinite; ReadSpec bounds the fields
+		//it casts to int
+		char digit = c == '-' && pos + 1 < text.size() ? text[pos + 1] : c;
+		if (digit < '0' || digit > '9')
+			return Fail("unexpected character");
+		char* end = NULL;
+		value.type = JSON_NUMBER;
+		value.number = strtod(text.c_str() + pos, &end);
+		if (end == text.c_str() + pos || strspn(text.c_str() + pos, "0123456789+-.eE") < (size_t)(end - text.c_str() - pos))
+			return Fail("unexpected character");
+		if (!isfinite(value.number))
+			return Fail("number out of range");
+		pos = end - text.c_str();
+		return true;
+	}
+};
+
+bool ParseJson(const std::string& text, JsonValue& value, std::string& error)
+{
+	JsonParser parser(text);
+	value = JsonValue();
+	if (!parser.Value(value))
+	{
+		error = parser.error;
+		return false;
+	}
+	parser.SkipSpace();
+	if (parser.pos != text.size())
+	{
+		parser.Fail("trailing characters");
+		error = parser.error;
+		return false;
+	}
+	return true;
+}
+
+bool ReadJsonFile(const std::string& path, JsonValue& value, std::string& error)
+{
+	std::ifstream stream(path.c_str());
+	if (!stream.is_open())
+	{
+		error = "cannot open " + path;
+		return false;
+	}
+	std::stringstream buffer;
+	buffer << stream.rdbuf();
+	if (!ParseJson(buffer.str(), value, error))
+	{
+		error = path + ", " + error;
+		return false;
+	}
+	return true;
+}
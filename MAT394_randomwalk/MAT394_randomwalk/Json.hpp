@@ -0,0 +1,43 @@
+/* Start Header -------------------------------------------------------
+File Name: Json.hpp
+Purpose: Small JSON reader for experiment specification files
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <string>
+#include <vector>
+
+enum JsonType {
+	JSON_NULL,
+	JSON_BOOL,
+	JSON_NUMBER,
+	JSON_STRING,
+	JSON_ARRAY,
+	JSON_OBJECT
+};
+
+// Objects keep their keys next to the values, in file order.
+struct JsonValue {
+	JsonType type = JSON_NULL;
+	bool boolean = false;
+	double number = 0.0;
+	std::string string;
+	std::vector<std::string> keys;
+	std::vector<JsonValue> items;
+
+	const JsonValue* Find(const std::string& key) const;
+};
+
+// Comments starting with // are skipped, so spec files can be annotated.
+bool ParseJson(const std::string& text, JsonValue& value, std::string& error);
+bool ReadJsonFile(const std::string& path, JsonValue& value, std::string& error);
+
+#endif
@@ -0,0 +1,233 @@
+/* Start Header -------------------------------------------------------
+File Name: LaplacianWalk.cpp
+Purpose: Laplacian random walk and exit-stopped loop erasure in a box
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "LaplacianWalk.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+//largest change of a relaxation sweep that counts as converged; SOR leaves
+//an error a few times this, far below any step probability that matters
+#define HARMONIC_TOLERANCE 1e-7
+
+LaplacianWalk::LaplacianWalk()
+{
+	radius = -1;
+	side = 0;
+	omega = 1.0;
+	for (int d = 0; d < 6; ++d)
+		stride[d] = 0;
+	rng.Seed(NextSeed());
+}
+
+void LaplacianWalk::SetRadius(int r)
+{
+	radius = r;
+	side = 2 * radius + 3;
+
+	//same order as Direction, so Below(6) picks the same step RandomWalk would
+	stride[0] = 1;
+	stride[1] = side;
+	stride[2] = side * side;
+	stride[3] = -1;
+	stride[4] = -side;
+	stride[5] = -side * side;
+
+	index.assign((size_t)side * side * side, -1);
+	harmonic.clear();
+	start.clear();
+	omega = 2.0 / (1.0 + sin(3.14159265358979 / (side - 1)));
+}
+
+bool LaplacianWalk::Outside(int site) const
+{
+	int x = site % side;
+	int y = site / side % side;
+	int z = site / (side * side);
+	return x == 0 || y == 0 || z == 0 || x == side - 1 || y == side - 1 || z == side - 1;
+}
+
+glm::vec3 LaplacianWalk::Point(int i) const
+{
+	int site = path[i];
+	return glm::vec3(site % side - radius - 1, site / side % side - radius - 1, site / (side * side) - radius - 1);
+}
+
+int LaplacianWalk::InnerLength() const
+{
+	int inner = 0;
+	for (size_t i = 1; i < path.size(); ++i)
+	{
+		glm::vec3 p = Point((int)i);
+		if (std::max(std::max(fabs(p.x), fabs(p.y)), fabs(p.z)) <= radius / 2)
+			++inner;
+	}
+	return inner;
+}
+
+// Red-black SOR on the box sites off the path. The outside layer stays at
+// 1 and the path at 0, so the result is the chance to escape before
+// touching the path.
+void LaplacianWalk::Relax()
+{
+	TRACE_ZONE_FINE("Relax");
+	const int plane = side * side;
+	double change = 1.0;
+	for (int sweep = 0; sweep < 50 * side && change > HARMONIC_TOLERANCE; ++sweep)
+	{
+		change = 0.0;
+		for (int color = 0; color < 2; ++color)
+		{
+			for (int z = 1; z < side - 1; ++z)
+			{
+				for (int y = 1; y < side - 1; ++y)
+				{
+					int x = 1 + (((1 + y + z) ^ color) & 1);
+					for (int site = Site(x, y, z); x < side - 1; x += 2, site += 2)
+					{
+						if (index[site] >= 0)
+							continue;
+						double* h = &harmonic[site];
+						double average = (h[-1] + h[1] + h[-side] + h[side] + h[-plane] + h[plane]) * (1.0 / 6.0);
+						double delta = omega * (average - *h);
+						*h += delta;
+						change = std::max(change, fabs(delta));
+					}
+				}
+			}
+		}
+	}
+}
+
+int LaplacianWalk::Grow()
+{
+	TRACE_ZONE_FINE("Grow");
+	int origin = Site(radius + 1, radius + 1, radius + 1);
+	index[origin] = 0;
+
+	//the solution with only the origin on the path is the same every
+	//trial, later steps start from the one before
+	if (start.empty())
+	{
+		harmonic.assign(index.size(), 1.0);
+		harmonic[origin] = 0.0;
+		Relax();
+		start = harmonic;
+	}
+	else
+		harmonic = start;
+
+	path.clear();
+	path.push_back(origin);
+	while (!Outside(path.back()))
+	{
+		int tip = path.back();
+		if (path.size() > 1)
+			Relax();
+
+		double weight[6];
+		double total = 0.0;
+		for (int d = 0; d < 6; ++d)
+		{
+			int site = tip + stride[d];
+			weight[d] = index[site] >= 0 ? 0.0 : std::max(harmonic[site], 0.0);
+			total += weight[d];
+		}
+
+		//rounding can leave u past the last weight, keep the last free one
+		double u = rng.Uniform() * total;
+		int next = -1;
+		for (int d = 0; d < 6; ++d)
+		{
+			if (weight[d] <= 0.0)
+				continue;
+			next = tip + stride[d];
+			if (u < weight[d])
+				break;
+			u -= weight[d];
+		}
+		StatAdd(STAT_STEPS);
+
+		//only a relaxation error can lead into a pocket sealed off by the
+		//path, start over rather than sample from noise
+		if (next < 0)
+		{
+			for (size_t i = 0; i < path.size(); ++i)
+				index[path[i]] = -1;
+			return Grow();
+		}
+
+		index[next] = (int)path.size();
+		path.push_back(next);
+		if (!Outside(next))
+			harmonic[next] = 0.0;
+	}
+
+	for (size_t i = 0; i < path.size(); ++i)
+		index[path[i]] = -1;
+	return (int)path.size() - 1;
+}
+
+// index[] holds the position of every path site, so finding and erasing a
+// loop costs its length and not a search of the whole path.
+int LaplacianWalk::GrowByErasure()
+{
+	TRACE_ZONE_FINE("GrowByErasure");
+	int origin = Site(radius + 1, radius + 1, radius + 1);
+	index[origin] = 0;
+	path.clear();
+	path.push_back(origin);
+
+	while (!Outside(path.back()))
+	{
+		int next = path.back() + stride[rng.Below(6)];
+		StatAdd(STAT_STEPS);
+		if (index[next] >= 0)
+		{
+			StatAdd(STAT_LOOPS_ERASED);
+			for (size_t i = index[next] + 1; i < path.size(); ++i)
+				index[path[i]] = -1;
+			path.resize(index[next] + 1);
+		}
+		else
+		{
+			index[next] = (int)path.size();
+			path.push_back(next);
+		}
+	}
+
+	for (size_t i = 0; i < path.size(); ++i)
+		index[path[i]] = -1;
+	return (int)path.size() - 1;
+}
+
+void LaplacianTrials(LaplacianWalk& walker, int radius, int trials, bool laplacian, float& length, float& inner_length)
+{
+	TRACE_ZONE("LaplacianTrials");
+	StatBusy busy;
+	if (walker.radius != radius)
+		walker.SetRadius(radius);
+
+	long long length_sum = 0;
+	long long inner_sum = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		TRACE_ZONE_FINE("Trial");
+		length_sum += laplacian ? walker.Grow() : walker.GrowByErasure();
+		inner_sum += walker.InnerLength();
+		StatAdd(STAT_TRIALS);
+	}
+
+	length = (float)length_sum / (float)trials;
+	inner_length = (float)inner_sum / (float)trials;
+}
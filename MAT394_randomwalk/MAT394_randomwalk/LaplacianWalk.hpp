@@ -0,0 +1,63 @@
+/* Start Header -------------------------------------------------------
+File Name: LaplacianWalk.hpp
+Purpose: Loop-erased walks to the boundary of a box, grown directly as a
+		 Laplacian random walk or by erasing a simple walk
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef LAPLACIANWALK_HPP
+#define LAPLACIANWALK_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+
+// Loop-erased walk from the origin until it first leaves [-radius, radius]^3.
+// The loop erasure of a simple walk stopped there and the Laplacian random
+// walk, where each step goes to a free neighbour with probability
+// proportional to the chance a simple walk from it reaches the outside
+// before the path, have the same law (Lawler), so the two Grow functions
+// sample the same paths by different means.
+class LaplacianWalk {
+public:
+	LaplacianWalk();
+
+	void SetRadius(int radius);
+
+	//the path ends on the first site outside the box
+	int Grow();
+	int GrowByErasure();
+
+	//steps of the path that stay within [-radius/2, radius/2]^3
+	int InnerLength() const;
+	glm::vec3 Point(int i) const;
+
+	std::vector<int> path;
+	int radius;
+	Rng rng;
+
+private:
+	int Site(int x, int y, int z) const { return (z * side + y) * side + x; }
+	bool Outside(int site) const;
+	void Relax();
+
+	//a layer of outside sites pads the box, so every box site has all
+	//six neighbours in the arrays
+	int side;
+	int stride[6];
+	std::vector<int> index;
+	std::vector<double> harmonic;
+	std::vector<double> start;
+	double omega;
+};
+
+// Averages of the path length and its inner length over trials paths.
+void LaplacianTrials(LaplacianWalk& walker, int radius, int trials, bool laplacian, float& length, float& inner_length);
+
+#endif
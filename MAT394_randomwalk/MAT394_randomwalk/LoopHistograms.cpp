@@ -0,0 +1,169 @@
+/* Start Header -------------------------------------------------------
+File Name: LoopHistograms.cpp
+Purpose: Registration, merging and export of loop histograms
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <algorithm>
+#include <vector>
+#include <mutex>
+
+#include "LoopHistograms.hpp"
+
+const char* HistogramNames[HIST_COUNT] = {
+	"loop_length",
+	"erasure_time",
+	"path_length",
+	"branch_length",
+	"tree_degree"
+};
+
+static ThreadHistograms slots[MAX_HISTOGRAM_THREADS];
+static std::atomic<int> slotCount(0);
+static ThreadHistograms overflow;
+static std::mutex slotMutex;
+
+thread_local ThreadHistograms* localHistograms = NULL;
+
+struct HistogramSlotRelease {
+	~HistogramSlotRelease()
+	{
+		std::lock_guard<std::mutex> lock(slotMutex);
+		if (localHistograms && !localHistograms->shared)
+			localHistograms->in_use.store(false, std::memory_order_relaxed);
+		overflow.shared = true;
+		localHistograms = &overflow;
+	}
+};
+
+ThreadHistograms* RegisterHistogramThread()
+{
+	if (localHistograms)
+		return localHistograms;
+	thread_local HistogramSlotRelease release;
+	(void)release;
+
+	std::lock_guard<std::mutex> lock(slotMutex);
+	int count = slotCount.load();
+	for (int i = 0; i < count; ++i)
+	{
+		if (!slots[i].in_use.load(std::memory_order_relaxed))
+		{
+			slots[i].in_use.store(true, std::memory_order_relaxed);
+			localHistograms = &slots[i];
+			return localHistograms;
+		}
+	}
+	if (count == MAX_HISTOGRAM_THREADS)
+	{
+		overflow.shared = true;
+		localHistograms = &overflow;
+		return localHistograms;
+	}
+
+	localHistograms = &slots[count];
+	localHistograms->in_use.store(true, std::memory_order_relaxed);
+	slotCount.store(count + 1);
+	return localHistograms;
+}
+
+long long HistogramBinStart(int bin)
+{
+	if (bin < 4)
+		return bin;
+	int octave = bin / 4 + 1;
+	return (long long)(4 + bin % 4) << (octave - 2);
+}
+
+static void AddSlot(HistogramSnapshot& snapshot, const ThreadHistograms& slot)
+{
+	for (int h = 0; h < HIST_COUNT; ++h)
+	{
+		for (int b = 0; b < HISTOGRAM_BINS; ++b)
+			snapshot.bins[h][b] += slot.bins[h][b].load(std::memory_order_relaxed);
+	}
+}
+
+void TakeHistogramSnapshot(HistogramSnapshot& snapshot)
+{
+	for (int h = 0; h < HIST_COUNT; ++h)
+	{
+		for (int b = 0; b < HISTOGRAM_BINS; ++b)
+			snapshot.bins[h][b] = 0;
+	}
+
+	int count = slotCount.load();
+	for (int i = 0; i < count; ++i)
+		AddSlot(snapshot, slots[i]);
+	AddSlot(snapshot, overflow);
+
+	snapshot.used = 0;
+	for (int h = 0; h < HIST_COUNT; ++h)
+	{
+		snapshot.total[h] = 0;
+		for (int b = 0; b < HISTOGRAM_BINS; ++b)
+		{
+			snapshot.total[h] += snapshot.bins[h][b];
+			if (snapshot.bins[h][b])
+				snapshot.used = std::max(snapshot.used, b + 1);
+		}
+	}
+}
+
+// Like ResetStats, only meant for the moments no experiment is running.
+void ResetHistograms()
+{
+	int count = slotCount.load();
+	for (int i = 0; i < count; ++i)
+	{
+		for (int h = 0; h < HIST_COUNT; ++h)
+		{
+			for (int b = 0; b < HISTOGRAM_BINS; ++b)
+				slots[i].bins[h][b].store(0, std::memory_order_relaxed);
+		}
+	}
+	for (int h = 0; h < HIST_COUNT; ++h)
+	{
+		for (int b = 0; b < HISTOGRAM_BINS; ++b)
+			overflow.bins[h][b].store(0, std::memory_order_relaxed);
+	}
+}
+
+bool WriteLoopHistograms(const std::string& path, const RunMetadata& meta)
+{
+	HistogramSnapshot snapshot;
+	TakeHistogramSnapshot(snapshot);
+
+	std::vector<ResultColumn> columns;
+	columns.push_back({ "bin_start", COLUMN_INT64 });
+	columns.push_back({ "bin_end", COLUMN_INT64 });
+	for (int h = 0; h < HIST_COUNT; ++h)
+		columns.push_back({ HistogramNames[h], COLUMN_INT64 });
+
+	RunMetadata run = meta;
+	run.trials = (int)snapshot.total[HIST_PATH_LENGTH];
+
+	ResultSink* sink = CreateResultSink(path);
+	if (!sink->Open(path, columns, run))
+	{
+		delete sink;
+		return false;
+	}
+
+	double row[2 + HIST_COUNT];
+	for (int b = 0; b < snapshot.used; ++b)
+	{
+		row[0] = (double)HistogramBinStart(b);
+		row[1] = (double)HistogramBinStart(b + 1);
+		for (int h = 0; h < HIST_COUNT; ++h)
+			row[2 + h] = (double)snapshot.bins[h][b];
+		sink->Append(row);
+	}
+	sink->Close();
+	delete sink;
+	return true;
+}
@@ -0,0 +1,92 @@
+/* Start Header -------------------------------------------------------
+File Name: LoopHistograms.hpp
+Purpose: Per-thread log-binned histograms of loop-erased walk sizes
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef LOOPHISTOGRAMS_HPP
+#define LOOPHISTOGRAMS_HPP
+
+#include <atomic>
+#include <string>
+
+#include "ResultSink.hpp"
+
+#define MAX_HISTOGRAM_THREADS 64
+
+//4 bins per power of two, enough for any int
+#define HISTOGRAM_BINS 128
+
+enum LoopHistogram {
+	HIST_LOOP_LENGTH,
+	HIST_ERASURE_TIME,
+	HIST_PATH_LENGTH,
+	HIST_BRANCH_LENGTH,
+	HIST_TREE_DEGREE,
+	HIST_COUNT
+};
+
+extern const char* HistogramNames[HIST_COUNT];
+
+// Same scheme as ThreadStats: one slot per thread, written only by it and
+// handed back when it exits, and a shared one with atomic adds for threads
+// that find no slot free. Slots have no names, any thread takes any free one.
+struct alignas(64) ThreadHistograms {
+	std::atomic<long long> bins[HIST_COUNT][HISTOGRAM_BINS];
+	std::atomic<bool> in_use;
+	bool shared;
+};
+
+struct HistogramSnapshot {
+	long long bins[HIST_COUNT][HISTOGRAM_BINS];
+	long long total[HIST_COUNT];
+	int used;
+};
+
+ThreadHistograms* RegisterHistogramThread();
+extern thread_local ThreadHistograms* localHistograms;
+
+// Values below 4 get a bin each, above that a power of two is split into
+// 4 bins, so bins are evenly spaced on a log axis with 19% width at most.
+inline int HistogramBin(unsigned int value)
+{
+	if (value < 4)
+		return (int)value;
+	int octave = 0;
+	for (unsigned int v = value; v > 1; v >>= 1)
+		++octave;
+	return 4 * (octave - 1) + (int)((value >> (octave - 2)) & 3);
+}
+
+// First value of a bin; the bin ends where the next one starts.
+long long HistogramBinStart(int bin);
+
+inline void HistAdd(LoopHistogram histogram, long long value)
+{
+#ifndef RW_NO_STATS
+	if (!localHistograms)
+		RegisterHistogramThread();
+	std::atomic<long long>& count = localHistograms->bins[histogram][HistogramBin((unsigned int)value)];
+	if (localHistograms->shared)
+		count.fetch_add(1, std::memory_order_relaxed);
+	else
+		count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#else
+	(void)histogram;
+	(void)value;
+#endif
+}
+
+void TakeHistogramSnapshot(HistogramSnapshot& snapshot);
+void ResetHistograms();
+
+// One row per bin: start, end, then a count column per histogram. The
+// trials of meta are replaced by the number of trials histogrammed.
+bool WriteLoopHistograms(const std::string& path, const RunMetadata& meta);
+
+#endif
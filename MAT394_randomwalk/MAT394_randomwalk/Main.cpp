@@ -16,6 +16,10 @@ End Header --------------------------------------------------------*/
 #include <sstream>
 #include <iostream>
 #include <time.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 
 // Include GLEW
 #include <GL/glew.h>
@@ -33,6 +37,15 @@ using namespace glm;
 #include "shader.hpp"
 #include "Graph.hpp"
 #include "Camera.hpp"
+#include "EngineStats.hpp"
+#include "LoopHistograms.hpp"
+#include "Trace.hpp"
+#include "FrameProfiler.hpp"
+#include "ResultSink.hpp"
+#include "Experiment.hpp"
+#include "ResultCache.hpp"
+#include "SpanningTree.hpp"
+#include "TrajectoryAnalysis.hpp"
 
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw_gl3.h"
@@ -50,6 +63,16 @@ struct GuiVar {
 	int xSize = 100;
 	int ySize = 100;
 	int zSize = 100;
+	bool stream_results = false;
+	int stream_format = 0;
+	int seed = 1;
+	bool use_cache = true;
+	char tree_path[256] = "tree.rwt";
+	float drift[3] = { 0.f, 0.f, 0.f };
+	float pull = 0.f;
+	bool correlated = false;
+	float persistence = 0.2f;
+	float reversal = 0.f;
 };
 
 struct Result {
@@ -57,6 +80,8 @@ struct Result {
 	float ave_dist;
 	float ave_largest;
 	float ave_num_loop;
+	float ave_range;
+	float ave_log_dist;
 };
 
 
@@ -72,19 +97,336 @@ glm::vec3 colors[9] = {
 	{ 0.86f, 0.6f, 0.86f } // plum
 };
 
-bool simulation_start = false;
+std::atomic<bool> simulation_start(false);
+std::atomic<bool> simulation_cancel(false);
 bool prob_simulation = false;
+std::vector<Result> result;
 std::vector<std::pair<int, float>> prob_result;
+//one per row of result or prob_result, what Refine adds trials to
+std::vector<PointAccumulator> accumulators;
+std::mutex result_mutex;
+std::thread simulation_worker;
+
+//steps the running decade sweep will take at most, for the ETA
+long long sweep_planned_steps = 0;
+long long sweep_start_steps = 0;
+
+//finished trial chunks, shared with Batch.exe run from the same folder
+ResultCache result_cache;
+
+//one Line::Draw per edge, like the path, so only small trees are drawn
+#define MAX_TREE_EDGES 50000
+
+//spanning tree written by Batch.exe, as start and end point of every edge
+std::vector<glm::vec3> tree_edges;
+std::string tree_message;
 
 // Set camera's position
 Camera camera(glm::vec3(50.f,10.f, 25.f));
 
+// What the sweep of the current mode runs.
+WalkKind SweepKind(const RandomWalk& rw, bool probability)
+{
+	if (probability)
+		return WALK_RETURN;
+	if (rw.kernel == KERNEL_GAUSSIAN)
+		return WALK_GAUSSIAN;
+	if (rw.kernel == KERNEL_LEVY)
+		return WALK_LEVY;
+	return rw.looperased ? WALK_LOOP_ERASED : WALK_NORMAL;
+}
+
+// A normal walk's point holds distance and range, a loop-erased one's
+// distance, largest loop and erased loops, an off-lattice one's distance
+// and log distance.
+void StoreResult(Result& r, WalkKind walk, const ExperimentPoint& point)
+{
+	r.ave_dist = (float)point.value[0];
+	r.ave_largest = walk == WALK_LOOP_ERASED ? (float)point.value[1] : 0.f;
+	r.ave_num_loop = walk == WALK_LOOP_ERASED ? (float)point.value[2] : 0.f;
+	r.ave_range = walk == WALK_NORMAL ? (float)point.value[1] : 0.f;
+	r.ave_log_dist = walk == WALK_GAUSSIAN || walk == WALK_LEVY ? (float)point.value[1] : 0.f;
+}
+
+// Runs the decade sweep off the render thread so the window stays live.
+void NumericalSimulation(RandomWalk rw, bool probability, std::string stream_path, unsigned long long seed, bool use_cache)
+{
+	RegisterStatsThread("simulation");
+	TRACE_THREAD("simulation");
+	ResultCache* cache = use_cache ? &result_cache : NULL;
+	WalkKind walk = SweepKind(rw, probability);
+
+	//every data point goes to the file as soon as it is done; a sweep has a
+	//handful of decades, so each can be its own record batch
+	ResultSink* sink = NULL;
+	if (!stream_path.empty())
+	{
+		std::vector<ResultColumn> columns;
+		ExperimentColumns(walk, columns);
+
+		RunMetadata meta;
+		meta.experiment = WalkKindNames[walk];
+		meta.lattice = CUBIC_LATTICE;
+		meta.box = DescribeBox(rw);
+		meta.seed = seed;
+		meta.trials = TRIALS;
+
+		sink = CreateResultSink(stream_path);
+		if (!sink->Open(stream_path, columns, meta))
+		{
+			fprintf(stderr, "Error : cannot write %s\n", stream_path.c_str());
+			delete sink;
+			sink = NULL;
+		}
+	}
+
+	//a decade already in the cache comes back at once
+	for (int steps = probability ? 100 : 10; steps < 1000000 && !simulation_cancel; steps *= 10)
+	{
+		TRACE_ZONE("Decade");
+		PointAccumulator acc;
+		InitAccumulator(acc, rw, walk, steps, TRIALS, seed);
+		if (!RefinePoint(acc, TRIALS, cache, &simulation_cancel))
+			break;
+		const ExperimentPoint& point = acc.point;
+
+		if (probability)
+		{
+			float l_prob = (float)point.value[0];
+
+			TRACE_ZONE("Store result");
+			if (sink)
+			{
+				double row[2] = { (double)steps, l_prob };
+				sink->Append(row);
+				sink->Flush();
+			}
+			std::lock_guard<std::mutex> lock(result_mutex);
+			if (!simulation_cancel)
+			{
+				prob_result.push_back(std::make_pair(steps, l_prob));
+				accumulators.push_back(acc);
+			}
+		}
+		else
+		{
+			Result l_result;
+			l_result.steps = steps;
+			StoreResult(l_result, walk, point);
+
+			TRACE_ZONE("Store result");
+			if (sink)
+			{
+				//the values are already in column order
+				double row[4] = { (double)steps, point.value[0], point.value[1], point.value[2] };
+				sink->Append(row);
+				sink->Flush();
+			}
+			std::lock_guard<std::mutex> lock(result_mutex);
+			if (!simulation_cancel)
+			{
+				result.push_back(l_result);
+				accumulators.push_back(acc);
+			}
+		}
+	}
+
+	if (sink)
+	{
+		sink->Close();
+		delete sink;
+	}
+	simulation_start = false;
+}
+
+// Runs trials more trials for every point of the last sweep and folds them
+// into the results, which only the error bars should notice.
+void RefineSimulation(int trials, bool use_cache)
+{
+	RegisterStatsThread("simulation");
+	TRACE_THREAD("simulation");
+	ResultCache* cache = use_cache ? &result_cache : NULL;
+
+	//only the render thread clears the points, and it cancels and joins this
+	//thread first
+	size_t count;
+	{
+		std::lock_guard<std::mutex> lock(result_mutex);
+		count = accumulators.size();
+	}
+	for (size_t k = 0; k < count && !simulation_cancel; ++k)
+	{
+		TRACE_ZONE("Refine");
+		PointAccumulator acc;
+		{
+			std::lock_guard<std::mutex> lock(result_mutex);
+			acc = accumulators[k];
+		}
+		RefinePoint(acc, trials, cache, &simulation_cancel);
+
+		//a cancel means the points are about to be cleared, or already are
+		std::lock_guard<std::mutex> lock(result_mutex);
+		if (simulation_cancel || k >= accumulators.size())
+			break;
+		accumulators[k] = acc;
+		if (acc.walk == WALK_RETURN)
+			prob_result[k].second = (float)acc.point.value[0];
+		else
+		{
+			StoreResult(result[k], acc.walk, acc.point);
+		}
+	}
+	simulation_start = false;
+}
+
+void StartRefine(int trials, const GuiVar& manage)
+{
+	if (simulation_worker.joinable())
+		simulation_worker.join();
+	simulation_cancel = false;
+
+	StatsSnapshot snapshot;
+	TakeStatsSnapshot(snapshot);
+	sweep_start_steps = snapshot.total[STAT_STEPS];
+	sweep_planned_steps = 0;
+	{
+		std::lock_guard<std::mutex> lock(result_mutex);
+		for (size_t k = 0; k < accumulators.size(); ++k)
+			sweep_planned_steps += (long long)accumulators[k].steps * trials;
+	}
+
+	simulation_start = true;
+	simulation_worker = std::thread(RefineSimulation, trials, manage.use_cache);
+}
+
+void StartNumericalSimulation(const RandomWalk& rw, bool probability, const GuiVar& manage)
+{
+	simulation_cancel = true;
+	if (simulation_worker.joinable())
+		simulation_worker.join();
+	simulation_cancel = false;
+
+	{
+		std::lock_guard<std::mutex> lock(result_mutex);
+		result.clear();
+		prob_result.clear();
+		accumulators.clear();
+	}
+	ResetHistograms();
+
+	std::string stream_path;
+	if (manage.stream_results)
+	{
+		char name[64];
+		time_t now = time(NULL);
+		strftime(name, sizeof(name), "results_%Y%m%d_%H%M%S", localtime(&now));
+		stream_path = std::string(name) + (manage.stream_format == 0 ? ".arrow" : ".csv");
+	}
+
+	StatsSnapshot snapshot;
+	TakeStatsSnapshot(snapshot);
+	sweep_start_steps = snapshot.total[STAT_STEPS];
+	sweep_planned_steps = 0;
+	for (int steps = probability ? 100 : 10; steps < 1000000; steps *= 10)
+		sweep_planned_steps += (long long)steps * TRIALS;
+
+	simulation_start = true;
+	simulation_worker = std::thread(NumericalSimulation, rw, probability, stream_path, (unsigned long long)manage.seed, manage.use_cache);
+}
+
+void LoadTree(const char* path)
+{
+	tree_edges.clear();
+	SpanningTree tree;
+	if (!tree.Read(path))
+		tree_message = std::string("Cannot read ") + path;
+	else if (tree.Sites() - 1 > MAX_TREE_EDGES)
+		tree_message = "The tree has " + std::to_string(tree.Sites() - 1) + " edges, too many to draw";
+	else
+	{
+		tree.Edges(tree_edges);
+		tree_message = std::to_string(tree_edges.size() / 2) + " edges";
+	}
+}
+
+void EngineStatsWindow(StatsSnapshot& prev, StatsSnapshot& curr)
+{
+	//rates are taken over half a second so they don't flicker every frame
+	StatsSnapshot now;
+	TakeStatsSnapshot(now);
+	if (now.time - curr.time >= 0.5)
+	{
+		prev = curr;
+		curr = now;
+	}
+	double dt = curr.time - prev.time;
+	if (dt <= 0.0)
+		dt = 1.0;
+
+	ImGui::Begin("Engine Stats");
+	for (int c = 0; c < STAT_COUNT; ++c)
+		ImGui::Text("%-20s %14lld   %12.0f /s", StatNames[c], now.total[c], (curr.total[c] - prev.total[c]) / dt);
+
+	ImGui::NewLine();
+	double rate = (curr.total[STAT_STEPS] - prev.total[STAT_STEPS]) / dt;
+	ImGui::Text("Steps per second : %.0f", rate);
+	if (simulation_start)
+	{
+		long long remaining = sweep_planned_steps - (now.total[STAT_STEPS] - sweep_start_steps);
+		if (rate > 0.0 && remaining > 0)
+			ImGui::Text("ETA : %.1f s (at most)", remaining / rate);
+		else
+			ImGui::Text("ETA : -");
+	}
+
+	ImGui::NewLine();
+	ImGui::Text("THREAD              STEPS      UTILIZATION");
+	for (size_t i = 0; i < curr.steps.size(); ++i)
+	{
+		if (!curr.running[i])
+			continue;
+		long long busy = curr.busy_ns[i] - (i < prev.busy_ns.size() ? prev.busy_ns[i] : 0);
+		ImGui::Text("%-12s %12lld      %5.1f %%", curr.names[i], curr.steps[i], 100.0 * busy * 1e-9 / dt);
+	}
+	HistogramSnapshot histograms;
+	TakeHistogramSnapshot(histograms);
+	if (histograms.total[HIST_LOOP_LENGTH])
+	{
+		ImGui::NewLine();
+		ImGui::Text("%lld loops erased in %lld trials", histograms.total[HIST_LOOP_LENGTH], histograms.total[HIST_PATH_LENGTH]);
+		if (ImGui::Button("Export Loop Histograms"))
+		{
+			RunMetadata meta;
+			meta.experiment = "loop_histograms";
+			meta.lattice = CUBIC_LATTICE;
+			meta.seed = 0;
+			meta.trials = 0;
+			WriteLoopHistograms("loop_histograms.arrow", meta);
+		}
+	}
+#ifdef RW_TRACE
+	ImGui::NewLine();
+	if (ImGui::Button("Export Trace"))
+		WriteChromeTrace("trace.json");
+	ImGui::SameLine();
+	if (ImGui::Button("Clear Trace"))
+		ClearTrace();
+#endif
+	ImGui::End();
+}
+
 int main(void) {
 	
 	GuiVar manage;
-	std::vector<Result> result;
-
-	srand(time(NULL));
+	StatsSnapshot stats_prev, stats_curr;
+	RegisterStatsThread("main");
+	TRACE_THREAD("main");
+	TakeStatsSnapshot(stats_curr);
+	stats_prev = stats_curr;
+
+	SeedRandom(time(NULL));
+	if (!result_cache.Open("cache"))
+		fprintf(stderr, "Cannot create the cache folder, sweeps will not be cached\n");
 	camera.aspect = aspects;
 	// Initialise GLFW
 	if (!glfwInit())
@@ -152,17 +494,22 @@ int main(void) {
 	Sphere head;
 	//RANDOM WALK STUFF
 	RandomWalk rw;
+	rw.keep_loop = true;
+
+	//PER-PASS FRAME TIMING
+	FrameProfiler profiler;
+	profiler.Init();
 
 	//simulation & analysis
 	bool simulation = true;
-	int numerical_steps = 10;
-	int prob_steps = 100;
 
 
 	float deltaTime = 0;
 	do {
+		TRACE_ZONE("Frame");
 
 		ImGui_ImplGlfwGL3_NewFrame();
+		profiler.BeginFrame();
 
 		float currFrame = (float)glfwGetTime();
 		deltaTime = currFrame - lastFrame;
@@ -174,13 +521,19 @@ int main(void) {
 
 		//////////////////IMGUI////////////////////////////////////
 		{
+			TRACE_ZONE("ImGui build");
 			ImGui::Begin("Simulation");
 			if (ImGui::Button("Visual Simulation"))
 			{
 				simulation = true;
-				numerical_steps = 10;
+				//the worker writes into the points until it stops, a chunk at most
+				simulation_cancel = true;
+				if (simulation_worker.joinable())
+					simulation_worker.join();
+				std::lock_guard<std::mutex> lock(result_mutex);
 				result.clear();
-				simulation_start = false;
+				prob_result.clear();
+				accumulators.clear();
 			}
 			if (ImGui::Button("Numerical Simulation"))
 				simulation = false;
@@ -193,33 +546,88 @@ int main(void) {
 			ImGui::NewLine();
 			if (ImGui::Button("Normal Random Walk"))
 			{
-				if (rw.looperased)
+				if (rw.looperased || rw.kernel != KERNEL_LATTICE)
 					rw.Reset();
 				rw.looperased = false;
+				rw.kernel = KERNEL_LATTICE;
 				rw.loop_exist = false;
 				prob_simulation = false;
 			}ImGui::SameLine();
 			if (ImGui::Button("Loop Erased Random Walk"))
 			{
-				if (!rw.looperased)
+				if (!rw.looperased || rw.kernel != KERNEL_LATTICE)
 					rw.Reset();
 				rw.looperased = true;
+				rw.kernel = KERNEL_LATTICE;
+				prob_simulation = false;
+			}
+			if (ImGui::Button("Gaussian Steps"))
+			{
+				if (rw.kernel != KERNEL_GAUSSIAN)
+					rw.Reset();
+				rw.looperased = false;
+				rw.loop_exist = false;
+				rw.kernel = KERNEL_GAUSSIAN;
+				prob_simulation = false;
+			}ImGui::SameLine();
+			if (ImGui::Button("Levy Flight"))
+			{
+				if (rw.kernel != KERNEL_LEVY)
+					rw.Reset();
+				rw.looperased = false;
+				rw.loop_exist = false;
+				rw.kernel = KERNEL_LEVY;
 				prob_simulation = false;
 			}
-			if (!simulation)
+			if (rw.kernel == KERNEL_LEVY)
+				ImGui::SliderFloat("Alpha", &rw.alpha, 0.1f, 2.0f);
+			if (rw.kernel == KERNEL_LATTICE)
+			{
+				//weight 1 + drift up and 1 - drift down along each axis
+				bool changed = ImGui::SliderFloat3("Drift", manage.drift, -0.9f, 0.9f);
+				changed |= ImGui::SliderFloat("Pull to Origin", &manage.pull, 0.f, 2.f);
+				if (changed)
+				{
+					double weights[6];
+					for (int a = 0; a < 3; ++a)
+					{
+						weights[a] = 1.0 + manage.drift[a];
+						weights[3 + a] = 1.0 - manage.drift[a];
+					}
+					rw.bias.Set(weights, manage.pull);
+					rw.biased = !rw.bias.IsUniform();
+				}
+
+				//repeat, undo or turn from the last step; reversal 0 never backtracks
+				changed = ImGui::Checkbox("Correlated Steps", &manage.correlated);
+				if (manage.correlated)
+				{
+					changed |= ImGui::SliderFloat("Persistence", &manage.persistence, 0.f, 1.f);
+					changed |= ImGui::SliderFloat("Reversal", &manage.reversal, 0.f, 1.f - manage.persistence);
+				}
+				if (changed)
+				{
+					manage.reversal = std::min(manage.reversal, 1.f - manage.persistence);
+					rw.bias.SetMemory(manage.correlated, manage.persistence, manage.reversal);
+					rw.biased = !rw.bias.IsUniform();
+				}
+			}
+			if (!simulation && rw.kernel == KERNEL_LATTICE)
 			{
 				if (ImGui::Button("Probability to Return to Origin"))
 				{
-					prob_result.clear();
-					prob_steps = 100;
-					simulation_start = true;
+					StartNumericalSimulation(rw, true, manage);
 					prob_simulation = true;
 				}
 			}
 			
 			ImGui::NewLine();
 
-			if (rw.looperased)
+			if (rw.kernel == KERNEL_GAUSSIAN)
+				ImGui::Text("Current Mode : Gaussian Steps in 3D");
+			else if (rw.kernel == KERNEL_LEVY)
+				ImGui::Text("Current Mode : Levy Flight in 3D, alpha %.2f", rw.alpha);
+			else if (rw.looperased)
 				ImGui::Text("Current Mode : Loop Erased Random Walk");
 			else
 				ImGui::Text("Current Mode : Normal Random Walk in 3D");
@@ -228,7 +636,10 @@ int main(void) {
 				ImGui::Text("Size of steps : %i", (int)rw.points.size()-2+rw.size_loop);
 			else
 				ImGui::Text("Size of steps : %i", (int)rw.points.size() - 2);
-			ImGui::Text("Current Position : (%i , %i, %i)", (int)rw.points.back().x, (int)rw.points.back().y, (int)rw.points.back().z);
+			if (rw.kernel != KERNEL_LATTICE)
+				ImGui::Text("Current Position : (%.2f , %.2f, %.2f)", rw.points.back().x, rw.points.back().y, rw.points.back().z);
+			else
+				ImGui::Text("Current Position : (%i , %i, %i)", (int)rw.points.back().x, (int)rw.points.back().y, (int)rw.points.back().z);
 			ImGui::Text("Distance from Origin : %.3f", rw.Distance());
 			ImGui::NewLine();
 			
@@ -293,6 +704,38 @@ int main(void) {
 
 				}
 
+				ImGui::NewLine();
+				ImGui::InputText("Tree file", manage.tree_path, sizeof(manage.tree_path));
+				if (ImGui::Button("Load Spanning Tree"))
+					LoadTree(manage.tree_path);
+				if (!tree_edges.empty())
+				{
+					ImGui::SameLine();
+					if (ImGui::Button("Hide Tree"))
+					{
+						tree_edges.clear();
+						tree_message.clear();
+					}
+				}
+				if (!tree_message.empty())
+					ImGui::Text("%s", tree_message.c_str());
+
+				if (!rw.looperased && rw.points.size() > 2)
+				{
+					if (ImGui::Button("Export MSD"))
+					{
+						TrajectoryStats stats;
+						AnalyzeTrajectory(rw.points, NULL, stats);
+						RunMetadata meta;
+						meta.experiment = "walk_msd";
+						meta.lattice = CUBIC_LATTICE;
+						meta.box = DescribeBox(rw);
+						meta.seed = 0;
+						meta.trials = 1;
+						WriteTrajectoryStats("walk_msd.arrow", stats, meta);
+					}
+				}
+
 
 				if (!manage.autoplay)
 				{
@@ -331,23 +774,49 @@ int main(void) {
 
 				if (ImGui::Button("Start"))
 				{
-					result.clear();
-					numerical_steps = 10;
-					simulation_start = true;
+					StartNumericalSimulation(rw, prob_simulation, manage);
+				}
+				ImGui::SameLine();
+				ImGui::Checkbox("Stream results to file", &manage.stream_results);
+				if (manage.stream_results)
+				{
+					ImGui::SameLine();
+					ImGui::RadioButton("Arrow", &manage.stream_format, 0);
+					ImGui::SameLine();
+					ImGui::RadioButton("CSV", &manage.stream_format, 1);
+				}
+				ImGui::PushItemWidth(100);
+				ImGui::InputInt("Seed", &manage.seed);
+				ImGui::PopItemWidth();
+				ImGui::SameLine();
+				ImGui::Checkbox("Use cache", &manage.use_cache);
+				if (result_cache.IsOpen())
+				{
+					ImGui::SameLine();
+					ImGui::Text("(%i chunks cached, %i computed)", result_cache.hits.load(), result_cache.misses.load());
 				}
 				if (simulation_start)
 				{
 					ImGui::SameLine();
 					ImGui::Text(" Now Calculating ...");
 				}
+				else if (!accumulators.empty())
+				{
+					//same seed and chunk streams, so the error bars only shrink
+					if (ImGui::Button("Refine (+1000 trials)"))
+						StartRefine(TRIALS, manage);
+				}
 
 				ImGui::Begin("Result");
+				std::lock_guard<std::mutex> lock(result_mutex);
 				if(prob_simulation)
 					ImGui::Text("	STEPS			Probability to Return to Origin");
+				else if (rw.kernel != KERNEL_LATTICE)
+					ImGui::Text("	  STEPS		  average distance		average log distance");
 				else
 				{
 					if (!rw.looperased)
-						ImGui::Text("	  STEPS		  average distance");
+						ImGui::Text("	  STEPS		  average distance		average range");
 					else
 						ImGui::Text("	  STEPS		  average distance		average largest loop		average erased loop");
 				}
@@ -355,7 +824,8 @@ int main(void) {
 				if (prob_simulation)
 				{
 					for(int k = 0; k < prob_result.size(); ++k)
-						ImGui::Text("%8i steps			%.6f" , prob_result[k].first, prob_result[k].second);
+						ImGui::Text("%8i steps			%.6f +- %.6f  (%i trials)" , prob_result[k].first, prob_result[k].second,
+							accumulators[k].point.error, accumulators[k].point.trials);
 				}
 				else
 				{
@@ -363,10 +833,13 @@ int main(void) {
 					{
 
 
-						if (!rw.looperased)
-							ImGui::Text("%5i steps			%3.3f", result[k].steps, result[k].ave_dist);
+						const ExperimentPoint& point = accumulators[k].point;
+						if (accumulators[k].walk == WALK_GAUSSIAN || accumulators[k].walk == WALK_LEVY)
+							ImGui::Text("%5i steps			%3.3f +- %.3f			%.3f	(%i trials)", result[k].steps, result[k].ave_dist, point.error, result[k].ave_log_dist, point.trials);
+						else if (!rw.looperased)
+							ImGui::Text("%5i steps			%3.3f +- %.3f			%.1f	(%i trials)", result[k].steps, result[k].ave_dist, point.error, result[k].ave_range, point.trials);
 						else
-							ImGui::Text("%5i steps			%3.3f					%.3f						%.5f", result[k].steps, result[k].ave_dist, result[k].ave_largest, result[k].ave_num_loop);
+							ImGui::Text("%5i steps			%3.3f +- %.3f			%.3f						%.5f	(%i trials)", result[k].steps, result[k].ave_dist, point.error, result[k].ave_largest, result[k].ave_num_loop, point.trials);
 
 
 					}
@@ -385,23 +858,32 @@ int main(void) {
 
 		if (simulation)
 		{
-
-			if (rw.looperased && !rw.loop_exist)
-				rw.CheckLoop();
+			{
+				TRACE_ZONE("Visual step");
+				profiler.BeginPass(PASS_SIMULATION);
+				if (rw.looperased && !rw.loop_exist)
+					rw.CheckLoop();
 
 
-			if (rw.steps < manage.MAX_STEP && manage.autoplay && !rw.loop_exist)
-			{
-				rw.Walk();
+				if (rw.steps < manage.MAX_STEP && manage.autoplay && !rw.loop_exist)
+				{
+					rw.Walk();
+				}
+				profiler.EndPass(PASS_SIMULATION);
 			}
 
 		
 			//DRAW COORDINATE WORLD
-			for (unsigned i = 0; i < coord.size(); ++i)
 			{
-				coord[i].m_Projection = camera.GetProjectionMatirx();
-				coord[i].m_View = camera.GetViewMatrix();
-				coord[i].Draw(programID, camera.position);
+				TRACE_ZONE("Draw axes");
+				profiler.BeginPass(PASS_AXES);
+				for (unsigned i = 0; i < coord.size(); ++i)
+				{
+					coord[i].m_Projection = camera.GetProjectionMatirx();
+					coord[i].m_View = camera.GetViewMatrix();
+					coord[i].Draw(programID, camera.position);
+				}
+				profiler.EndPass(PASS_AXES);
 			}
 
 			line.m_Projection = camera.GetProjectionMatirx();
@@ -414,33 +896,53 @@ int main(void) {
 			head.m_View = camera.GetViewMatrix();
 			head.center = rw.points.back();
 			head.scale = glm::vec3(0.3f, 0.3f, 0.3f);
-			head.Draw(programID, camera.position);
+			{
+				TRACE_ZONE("Draw head");
+				profiler.BeginPass(PASS_HEAD);
+				head.Draw(programID, camera.position);
+				profiler.EndPass(PASS_HEAD);
+			}
 
 			int colorindex = -1;
 			//DRAW LINES
-			for (size_t i = 0; i < rw.points.size() - 1; ++i)
 			{
-				//set color
-				if (i % 40 == 0)
+				TRACE_ZONE("Draw path");
+				profiler.BeginPass(PASS_PATH);
+				for (size_t i = 0; i < rw.points.size() - 1; ++i)
 				{
-					++colorindex;
-					if (colorindex > 8)
-						colorindex = 0;
+					//set color
+					if (i % 40 == 0)
+					{
+						++colorindex;
+						if (colorindex > 8)
+							colorindex = 0;
+					}
+
+					line.color = colors[colorindex];
+					line.SetStartEnd(rw.points[i], rw.points[i + 1]);
+					line.Draw(programID, camera.position);
 				}
 
-				line.color = colors[colorindex];
-				line.SetStartEnd(rw.points[i], rw.points[i + 1]);
-				line.Draw(programID, camera.position);
+				line.color = colors[8];
+				for (size_t i = 0; i < tree_edges.size(); i += 2)
+				{
+					line.SetStartEnd(tree_edges[i], tree_edges[i + 1]);
+					line.Draw(programID, camera.position);
+				}
+				profiler.EndPass(PASS_PATH);
 			}
 
 
 			if (rw.loop_exist)
 			{
+				TRACE_ZONE("Draw loop");
+				profiler.BeginPass(PASS_LOOP);
 				for (size_t i = 0; i < rw.loop.size() - 1; ++i)
 				{
 					loop_line.SetStartEnd(rw.loop[i], rw.loop[i + 1]);
 					loop_line.Draw(programID, camera.position);
 				}
+				profiler.EndPass(PASS_LOOP);
 
 				if (manage.autoplay)
 					++rw.num_loop;
@@ -448,53 +950,40 @@ int main(void) {
 			}
 
 		}
-		if(simulation_start && !prob_simulation)
-		{
-			
-			Result l_result;
-
-			l_result.steps = numerical_steps;
-			if (rw.looperased)
-				LoopErasedSimulation(l_result.steps, rw, l_result.ave_dist, l_result.ave_largest, l_result.ave_num_loop);
-			else
-				NormalSimulation(l_result.steps, rw, l_result.ave_dist);
 
-			result.push_back(l_result);
+		EngineStatsWindow(stats_prev, stats_curr);
+		profiler.Draw();
 
-			numerical_steps *= 10;
-			if (numerical_steps == 1000000)
-				simulation_start = false;
-		}
-		if (prob_simulation && simulation_start)
 		{
-			float l_prob;
-
-			ProbabilityToReturn(rw, l_prob, prob_steps);
-			prob_result.push_back(std::make_pair(prob_steps, l_prob));
-
-			prob_steps *= 10;
-			if (prob_steps == 1000000)
-				simulation_start = false;
-			
-
+			TRACE_ZONE("ImGui render");
+			profiler.BeginPass(PASS_IMGUI);
+			ImGui::Render();
+			ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+			profiler.EndPass(PASS_IMGUI);
 		}
 
-		ImGui::Render();
-		ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
-
 		// Swap buffers
-		glfwSwapBuffers(window);
-		glfwPollEvents();
+		{
+			TRACE_ZONE("Swap");
+			glfwSwapBuffers(window);
+			glfwPollEvents();
+		}
+		profiler.EndFrame();
 
 	} // Check if the ESC key was pressed or the window was closed
 	while (glfwGetKey(window, GLFW_KEY_ESCAPE) != GLFW_PRESS &&
 		glfwWindowShouldClose(window) == 0);
 
+	simulation_cancel = true;
+	if (simulation_worker.joinable())
+		simulation_worker.join();
+
 	coord[0].Clear();
 	coord[1].Clear();
 	coord[2].Clear();
 
 	line.Clear();
+	profiler.Clear();
 
 	ImGui_ImplGlfwGL3_Shutdown();
 	ImGui::DestroyContext();
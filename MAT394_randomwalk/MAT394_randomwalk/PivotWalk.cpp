@@ -0,0 +1,272 @@
+/* Start Header -------------------------------------------------------
+File Name: PivotWalk.cpp
+Purpose: Pivot algorithm, site hash table and autocorrelation estimate
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "PivotWalk.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+#define EMPTY_KEY (~0ull)
+
+//coordinates are hashed modulo 2^21; two sites of a walk of fewer than
+//2^21 steps never differ by that much, so their keys never clash
+#define COORD_MASK ((1u << 21) - 1)
+
+//the 6 axis permutations; a symmetry is permutation * 8 + sign bits, and
+//0 is the identity
+static const int Perm[6][3] = {
+	{ 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+};
+
+static glm::ivec3 ApplySymmetry(int symmetry, const glm::ivec3& v)
+{
+	const int* perm = Perm[symmetry >> 3];
+	glm::ivec3 r(v[perm[0]], v[perm[1]], v[perm[2]]);
+	if (symmetry & 1)
+		r.x = -r.x;
+	if (symmetry & 2)
+		r.y = -r.y;
+	if (symmetry & 4)
+		r.z = -r.z;
+	return r;
+}
+
+////////////////////////////////////////////////////////////////////// TABLE
+
+static uint64_t SiteKey(const glm::ivec3& site)
+{
+	return ((uint64_t)((uint32_t)site.x & COORD_MASK) << 42) | ((uint64_t)((uint32_t)site.y & COORD_MASK) << 21) | (uint64_t)((uint32_t)site.z & COORD_MASK);
+}
+
+void SiteTable::Reserve(int sites)
+{
+	//the walk and up to as many stale entries at most half full
+	size_t capacity = 16;
+	shift = 60;
+	while (capacity < (size_t)sites * 4)
+	{
+		capacity *= 2;
+		--shift;
+	}
+	keys.assign(capacity, EMPTY_KEY);
+	values.assign(capacity, -1);
+	mask = capacity - 1;
+	used = 0;
+}
+
+void SiteTable::Clear()
+{
+	std::fill(keys.begin(), keys.end(), EMPTY_KEY);
+	used = 0;
+}
+
+int SiteTable::Find(const glm::ivec3& site) const
+{
+	uint64_t key = SiteKey(site);
+	for (size_t i = Slot(key); keys[i] != EMPTY_KEY; i = (i + 1) & mask)
+	{
+		if (keys[i] == key)
+			return values[i];
+	}
+	return -1;
+}
+
+void SiteTable::Insert(const glm::ivec3& site, int index)
+{
+	uint64_t key = SiteKey(site);
+	size_t i = Slot(key);
+	while (keys[i] != EMPTY_KEY && keys[i] != key)
+		i = (i + 1) & mask;
+	if (keys[i] == EMPTY_KEY)
+		++used;
+	keys[i] = key;
+	values[i] = index;
+}
+
+////////////////////////////////////////////////////////////////////// WALK
+
+PivotWalk::PivotWalk()
+{
+	attempts = 0;
+	accepted = 0;
+	gyration = 0.0;
+	gyrationValid = false;
+	rng.Seed(NextSeed());
+}
+
+void PivotWalk::Reset(int n)
+{
+	sites.resize(n + 1);
+	for (int i = 0; i <= n; ++i)
+		sites[i] = glm::ivec3(i, 0, 0);
+	table.Reserve(n + 1);
+	Rebuild();
+	attempts = 0;
+	accepted = 0;
+	gyrationValid = false;
+}
+
+// Drops the stale entries, once they fill the table; that is after at least
+// as many moved sites as the walk has, so it adds O(1) per moved site.
+void PivotWalk::Rebuild()
+{
+	table.Clear();
+	for (size_t i = 0; i < sites.size(); ++i)
+		table.Insert(sites[i], (int)i);
+}
+
+bool PivotWalk::Attempt()
+{
+	TRACE_ZONE_FINE("Pivot");
+	++attempts;
+	int n = (int)sites.size() - 1;
+	if (n < 2)
+		return false;
+
+	//pivots at the ends change nothing
+	int k = 1 + (int)rng.Below(n - 1);
+	int symmetry = 1 + (int)rng.Below(47);
+
+	//turning either end gives the same shape, so turn the shorter one
+	int dir = n - k <= k ? 1 : -1;
+	int count = dir > 0 ? n - k : k;
+	glm::ivec3 pivot = sites[k];
+	moved.resize(count);
+	for (int i = 1; i <= count; ++i)
+	{
+		glm::ivec3 p = pivot + ApplySymmetry(symmetry, sites[k + dir * i] - pivot);
+		int j = table.Find(p);
+		if (j >= 0 && sites[j] == p && (dir > 0 ? j <= k : j >= k))
+		{
+			StatAdd(STAT_PROBES, i);
+			return false;
+		}
+		moved[i - 1] = p;
+	}
+	StatAdd(STAT_PROBES, count);
+
+	//the old sites of the moved end stay behind as stale entries
+	for (int i = 1; i <= count; ++i)
+	{
+		sites[k + dir * i] = moved[i - 1];
+		table.Insert(moved[i - 1], k + dir * i);
+	}
+	++accepted;
+	gyrationValid = false;
+
+	//turning the start moves the walk as a whole; shift it back now and
+	//then so the coordinates stay far from overflowing
+	bool rebuild = table.Full();
+	for (int a = 0; a < 3; ++a)
+	{
+		if (abs(sites[0][a]) > (1 << 29))
+		{
+			int shift = sites[0][a];
+			for (size_t i = 0; i < sites.size(); ++i)
+				sites[i][a] -= shift;
+			rebuild = true;
+		}
+	}
+	if (rebuild)
+		Rebuild();
+	return true;
+}
+
+double PivotWalk::EndToEnd2() const
+{
+	glm::ivec3 d = sites.back() - sites.front();
+	return (double)d.x * d.x + (double)d.y * d.y + (double)d.z * d.z;
+}
+
+// Exact sums relative to the first site, recomputed only after a pivot
+// was accepted.
+double PivotWalk::Gyration2()
+{
+	if (gyrationValid)
+		return gyration;
+
+	long long sum[3] = { 0, 0, 0 };
+	long long sum2 = 0;
+	for (size_t i = 0; i < sites.size(); ++i)
+	{
+		glm::ivec3 d = sites[i] - sites[0];
+		sum[0] += d.x;
+		sum[1] += d.y;
+		sum[2] += d.z;
+		sum2 += (long long)d.x * d.x + (long long)d.y * d.y + (long long)d.z * d.z;
+	}
+	double m = (double)sites.size();
+	gyration = sum2 / m - ((double)sum[0] * sum[0] + (double)sum[1] * sum[1] + (double)sum[2] * sum[2]) / (m * m);
+	gyrationValid = true;
+	return gyration;
+}
+
+double IntegratedAutocorrelation(const std::vector<double>& series)
+{
+	size_t n = series.size();
+	if (n < 2)
+		return 0.5;
+
+	double mean = 0.0;
+	for (size_t i = 0; i < n; ++i)
+		mean += series[i];
+	mean /= n;
+
+	double c0 = 0.0;
+	for (size_t i = 0; i < n; ++i)
+		c0 += (series[i] - mean) * (series[i] - mean);
+	c0 /= n;
+	if (c0 <= 0.0)
+		return 0.5;
+
+	double tau = 0.5;
+	for (size_t t = 1; t < n; ++t)
+	{
+		double c = 0.0;
+		for (size_t i = 0; i + t < n; ++i)
+			c += (series[i] - mean) * (series[i + t] - mean);
+		tau += c / (n - t) / c0;
+		if (t >= 6.0 * tau)
+			break;
+	}
+	return tau;
+}
+
+void PivotTrials(PivotWalk& walker, int steps, int trials, float& end_to_end2, float& gyration2, float& tau)
+{
+	TRACE_ZONE("PivotTrials");
+	StatBusy busy;
+
+	//every chunk is its own chain, started from the rod; global sizes
+	//forget the rod after a few dozen accepted pivots, this is well past it
+	walker.Reset(steps);
+	int burnin = 100 + 20 * (int)sqrt((double)steps);
+	for (int i = 0; i < burnin; ++i)
+		walker.Attempt();
+
+	std::vector<double> series(trials);
+	double e2_sum = 0.0;
+	double g2_sum = 0.0;
+	for (int i = 0; i < trials; ++i)
+	{
+		walker.Attempt();
+		series[i] = walker.EndToEnd2();
+		e2_sum += series[i];
+		g2_sum += walker.Gyration2();
+		StatAdd(STAT_TRIALS);
+	}
+
+	end_to_end2 = (float)(e2_sum / trials);
+	gyration2 = (float)(g2_sum / trials);
+	tau = (float)IntegratedAutocorrelation(series);
+}
@@ -0,0 +1,86 @@
+/* Start Header -------------------------------------------------------
+File Name: PivotWalk.hpp
+Purpose: Self-avoiding walks sampled with the pivot algorithm
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef PIVOTWALK_HPP
+#define PIVOTWALK_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+
+// Site -> index on the walk, open addressing with linear probing. Entries
+// are never removed: a pivot writes the new sites over whatever the keys
+// held, and an entry is only trusted if the walk still has that site at that
+// index. Walks must have fewer than 2^21 steps.
+class SiteTable {
+public:
+	//room for sites entries and as many stale ones
+	void Reserve(int sites);
+	void Clear();
+	int Find(const glm::ivec3& site) const;
+	void Insert(const glm::ivec3& site, int index);
+	bool Full() const { return used * 2 > keys.size(); }
+
+private:
+	size_t Slot(uint64_t key) const { return (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift); }
+
+	std::vector<uint64_t> keys;
+	std::vector<int> values;
+	size_t mask;
+	size_t used;
+	int shift;
+};
+
+// Madras-Sokal pivot algorithm: pick a site of the walk and one of the 47
+// non-trivial symmetries of the cubic lattice, apply it to the shorter end
+// of the walk around that site, and keep the result if it is still self
+// avoiding. The new sites are checked outwards from the pivot, where a
+// collision is most likely, so most rejections cost only a few lookups.
+class PivotWalk {
+public:
+	PivotWalk();
+
+	//straight rod of n steps
+	void Reset(int n);
+	bool Attempt();
+
+	double EndToEnd2() const;
+	//recomputed in O(n) at most once per accepted pivot
+	double Gyration2();
+	glm::vec3 Point(int i) const { return glm::vec3(sites[i]); }
+
+	std::vector<glm::ivec3> sites;
+	long long attempts;
+	long long accepted;
+	Rng rng;
+
+private:
+	void Rebuild();
+
+	SiteTable table;
+	std::vector<glm::ivec3> moved;
+	double gyration;
+	bool gyrationValid;
+};
+
+// Integrated autocorrelation time of series with Sokal's automatic window
+// (the window grows until it is 6 times the estimate).
+double IntegratedAutocorrelation(const std::vector<double>& series);
+
+// One chain: burn-in from the rod, then trials pivot attempts recording the
+// end-to-end distance^2 after each one and the radius of gyration^2.
+// tau is the integrated autocorrelation time of the end-to-end series in
+// attempts.
+void PivotTrials(PivotWalk& walker, int steps, int trials, float& end_to_end2, float& gyration2, float& tau);
+
+#endif
@@ -0,0 +1,75 @@
+/* Start Header -------------------------------------------------------
+File Name: Random.cpp
+Purpose: Seeding and stream splitting of the walk random number generator
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <atomic>
+
+#include "Random.hpp"
+
+static std::atomic<uint64_t> seedBase(0);
+static std::atomic<uint64_t> seedCount(0);
+
+uint64_t SplitMix64(uint64_t& state)
+{
+	uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+uint64_t MixSeed(uint64_t a, uint64_t b)
+{
+	uint64_t state = a;
+	uint64_t mixed = SplitMix64(state) ^ b;
+	return SplitMix64(mixed);
+}
+
+void Rng::Seed(uint64_t seed)
+{
+	uint64_t state = seed;
+	for (int i = 0; i < 4; ++i)
+		s[i] = SplitMix64(state);
+}
+
+// Advances 2^128 steps: up to 2^128 streams that never overlap.
+void Rng::Jump()
+{
+	static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+	uint64_t t[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int b = 0; b < 64; ++b)
+		{
+			if (JUMP[i] & (1ULL << b))
+			{
+				t[0] ^= s[0];
+				t[1] ^= s[1];
+				t[2] ^= s[2];
+				t[3] ^= s[3];
+			}
+			Next();
+		}
+	}
+	s[0] = t[0];
+	s[1] = t[1];
+	s[2] = t[2];
+	s[3] = t[3];
+}
+
+void SeedRandom(uint64_t seed)
+{
+	seedBase = seed;
+	seedCount = 0;
+}
+
+uint64_t NextSeed()
+{
+	return MixSeed(seedBase, seedCount++);
+}
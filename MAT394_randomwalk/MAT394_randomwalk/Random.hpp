@@ -0,0 +1,65 @@
+/* Start Header -------------------------------------------------------
+File Name: Random.hpp
+Purpose: Seedable per-walk random number generator
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <stdint.h>
+
+// xoshiro256** (Blackman and Vigna). Every RandomWalk owns one, so walks on
+// different threads never share state and a seed reproduces a run exactly.
+class Rng {
+public:
+	Rng() { Seed(0); }
+	explicit Rng(uint64_t seed) { Seed(seed); }
+
+	void Seed(uint64_t seed);
+	void Jump();
+
+	uint64_t Next()
+	{
+		const uint64_t result = Rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = Rotl(s[3], 45);
+		return result;
+	}
+
+	//uniform in [0, n) by multiply and shift, no division
+	unsigned Below(unsigned n)
+	{
+		return (unsigned)(((Next() >> 32) * n) >> 32);
+	}
+
+	//uniform in [0, 1)
+	double Uniform()
+	{
+		return (Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	uint64_t s[4];
+
+private:
+	static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+uint64_t SplitMix64(uint64_t& state);
+uint64_t MixSeed(uint64_t a, uint64_t b);
+
+// Base seed for walks that are not seeded explicitly, the srand of the engine.
+void SeedRandom(uint64_t seed);
+uint64_t NextSeed();
+
+#endif
@@ -0,0 +1,352 @@
+/* Start Header -------------------------------------------------------
+File Name: RandomWalk.cpp
+Purpose: Random walk on the cubic lattice and numerical simulations.
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include "RandomWalk.hpp"
+#include "EngineStats.hpp"
+#include "LoopHistograms.hpp"
+#include "RangeTracker.hpp"
+#include "FastForward.hpp"
+#include "ContinuousWalk.hpp"
+#include "Trace.hpp"
+
+static const glm::ivec3 Steps[6] = {
+	glm::ivec3(1, 0, 0), glm::ivec3(0, 1, 0), glm::ivec3(0, 0, 1),
+	glm::ivec3(-1, 0, 0), glm::ivec3(0, -1, 0), glm::ivec3(0, 0, -1)
+};
+
+void RandomWalk::Walk()
+{
+	TRACE_ZONE_FINE("Walk");
+	glm::vec3 laststep = points.back();
+	bool done = false;
+	int rejections = 0;
+	int newdirection = STEP_FIRST;
+	int last = last_direction;
+
+	while (!done)
+	{
+		if (kernel != KERNEL_LATTICE)
+		{
+			laststep += glm::vec3(ContinuousStep(rng, kernel, alpha));
+		}
+		else
+		{
+			newdirection = biased ? bias.Sample(rng, laststep, last) : rng.Below(6);
+			switch (newdirection)
+			{
+			case Direction::X_UP:
+				++laststep.x;
+				break;
+			case Direction::Y_UP:
+				++laststep.y;
+				break;
+			case Direction::Z_UP:
+				++laststep.z;
+				break;
+			case Direction::X_DOWN:
+				--laststep.x;
+				break;
+			case Direction::Y_DOWN:
+				--laststep.y;
+				break;
+			case Direction::Z_DOWN:
+				--laststep.z;
+				break;
+			}
+		}
+
+		if (!limit)
+			done = true;
+		else
+		{
+			if (laststep.x > limit_max.x || laststep.y > limit_max.y || laststep.z > limit_max.z
+				|| laststep.x < limit_min.x || laststep.y < limit_min.y || laststep.z < limit_min.z)
+			{
+				laststep = points.back();
+				++rejections;
+				if (biased && bias.memory && last != STEP_FIRST && bias.Blocked(laststep, last, limit_min, limit_max))
+					last = STEP_FIRST;
+			}
+			else
+				done = true;
+
+		}
+
+	}
+
+	if (rejections)
+		StatAdd(STAT_REJECTIONS, rejections);
+	if (points.size() == points.capacity())
+		StatAdd(STAT_ALLOCATIONS);
+	StatAdd(STAT_STEPS);
+
+	++steps;
+	points.push_back(laststep);
+	last_direction = newdirection;
+
+}
+
+void RandomWalk::RemoveLast()
+{
+	if (steps == 0)
+		return;
+
+	points.pop_back();
+	--steps;
+
+	//the step before is the one the walk goes on from
+	last_direction = STEP_FIRST;
+	if (steps > 0)
+	{
+		glm::vec3 step = points.back() - points[points.size() - 2];
+		for (int d = 0; d < 6; ++d)
+		{
+			if (step == glm::vec3(Steps[d]))
+				last_direction = d;
+		}
+	}
+
+}
+
+float RandomWalk::Distance()
+{
+	return glm::distance(startPosition, points.back());
+}
+
+void RandomWalk::Reset()
+{
+	points.clear();
+	points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+	points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+	startPosition = points.front();
+	steps = 0;
+	last_direction = STEP_FIRST;
+	num_loop = 0;
+	size_loop = 0;
+	biggest_loop = 0;
+	loop_exist = false;
+	loop_start = 0;
+	loop.clear();
+	visited.Clear();
+
+}
+
+void RandomWalk::CheckLoop()
+{
+	TRACE_ZONE_FINE("CheckLoop");
+	//points[0] is the start and not part of the path, the path begins at
+	//points[1]; the index knows every path site before the tip
+	int tip = (int)points.size() - 1;
+	if (!visited.Ready() || !visited.Covers(points.back()))
+		visited.Build(points, 1, tip - 1, limit, limit_min, limit_max);
+
+	int found = visited.Find(points.back());
+	StatAdd(STAT_PROBES);
+	if (found < 1 || found >= tip || points[found] != points.back())
+	{
+		visited.Set(points.back(), tip);
+		loop_exist = false;
+		loop.clear();
+	}
+	else
+	{
+		loop_exist = true;
+		StatAdd(STAT_LOOPS_ERASED);
+		loop_start = found;
+		size_loop = tip - found;
+		HistAdd(HIST_LOOP_LENGTH, size_loop);
+		HistAdd(HIST_ERASURE_TIME, steps);
+
+		if (keep_loop)
+		{
+			if ((size_t)size_loop + 1 > loop.capacity())
+				StatAdd(STAT_ALLOCATIONS);
+			loop.assign(points.begin() + loop_start, points.end());
+		}
+
+		//the tip is the vertex the loop started from, so cutting the path
+		//right after it erases the loop without moving anything; the index
+		//keeps the erased sites, they fail the check against points
+		points.resize(loop_start + 1);
+
+		if (biggest_loop < size_loop)
+			biggest_loop = size_loop;
+		
+	}
+
+}
+
+// The *Trials functions run on the walker they are given, so a caller that
+// keeps one walker per thread reuses its buffers from one batch to the next.
+void NormalTrials(RandomWalk& walker, int steps, int trials, float& distance, float& range)
+{
+	TRACE_ZONE("NormalSimulation");
+	StatBusy busy;
+	thread_local RangeTracker tracker;
+	float sum = 0;
+	long long range_sum = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		TRACE_ZONE_FINE("Trial");
+		walker.Reset();
+		tracker.Begin(walker);
+		for (int j = 0; j < steps; ++j)
+		{
+			walker.Walk();
+			tracker.Visit(walker.points.back());
+
+		}
+
+		sum += walker.Distance();
+		range_sum += tracker.Count();
+		StatAdd(STAT_TRIALS);
+
+	}
+
+	distance = sum / (float)trials;
+	range = (float)range_sum / (float)trials;
+}
+
+void LoopErasedTrials(RandomWalk& walker, int steps, int trials, float& distance, float& largest_loop, float& erased_loop)
+{
+	TRACE_ZONE("LoopErasedSimulation");
+	StatBusy busy;
+	int largetest_loop_sum = 0;
+	int erased_loop_sum = 0;
+	float sum = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		TRACE_ZONE_FINE("Trial");
+		walker.Reset();
+		for (int j = 0; j < steps; ++j)
+		{
+			walker.Walk();
+			walker.CheckLoop();
+			if (walker.loop_exist)
+				++walker.num_loop;
+
+		}
+
+		sum += walker.Distance();
+		HistAdd(HIST_PATH_LENGTH, walker.points.size() - 2);
+		largetest_loop_sum += walker.biggest_loop;
+		erased_loop_sum += walker.num_loop;
+		StatAdd(STAT_TRIALS);
+	}
+
+	distance = sum / (float)trials;
+	largest_loop = (float)largetest_loop_sum / (float)trials;
+	erased_loop = (float)erased_loop_sum / (float)trials;
+
+}
+
+// Away from the origin and the walls the walk jumps across the largest cube
+// around it that holds neither: it cannot come back inside such a cube, and
+// cannot be turned back by a wall, so the jump has the law of the steps it
+// replaces. A return can only happen on leaving a cube whose face holds the
+// origin, and a walk still inside a cube at the horizon never returned.
+// The jumps rely on the steps being uniform; a biased walk takes them one
+// at a time.
+void ReturnTimeTrials(RandomWalk& walker, const std::vector<int>& edges, int trials, std::vector<long long>& counts)
+{
+	TRACE_ZONE("ProbabilityToReturn");
+	StatBusy busy;
+	counts.assign(edges.size() - 1, 0);
+	int steps = edges.back() - 1;
+	glm::ivec3 low((int)ceil(walker.limit_min.x), (int)ceil(walker.limit_min.y), (int)ceil(walker.limit_min.z));
+	glm::ivec3 high((int)floor(walker.limit_max.x), (int)floor(walker.limit_max.y), (int)floor(walker.limit_max.z));
+
+	long long walked = 0;
+	long long rejections = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		TRACE_ZONE_FINE("Trial");
+		glm::ivec3 p(0, 0, 0);
+		int last = STEP_FIRST;
+		int t = 0;
+		while (t < steps)
+		{
+			int room = std::max(abs(p.x), std::max(abs(p.y), abs(p.z)));
+			if (walker.limit)
+			{
+				glm::ivec3 wall = glm::min(p - low, high - p);
+				room = std::min(room, std::min(wall.x, std::min(wall.y, wall.z)));
+			}
+			int level = walker.biased ? 0 : CubeLevel(room);
+			if (level)
+			{
+				int time;
+				glm::ivec3 offset;
+				CubeJumps(level).Sample(walker.rng, time, offset);
+				if (t + time > steps)
+					break;
+				t += time;
+				p += offset;
+			}
+			else
+			{
+				int d = walker.biased ? walker.bias.Sample(walker.rng, glm::vec3(p), last) : walker.rng.Below(6);
+				glm::ivec3 q = p + Steps[d];
+				if (walker.limit && (q.x < low.x || q.y < low.y || q.z < low.z || q.x > high.x || q.y > high.y || q.z > high.z))
+				{
+					++rejections;
+					if (walker.biased && walker.bias.memory && last != STEP_FIRST && walker.bias.Blocked(glm::vec3(p), last, walker.limit_min, walker.limit_max))
+						last = STEP_FIRST;
+					continue;
+				}
+				++t;
+				p = q;
+				last = d;
+			}
+
+			if (p == glm::ivec3(0, 0, 0))
+			{
+				//once per walk, the search is nothing next to the steps
+				++counts[std::upper_bound(edges.begin(), edges.end(), t) - edges.begin() - 1];
+				break;
+			}
+		}
+		walked += std::min(t, steps);
+		StatAdd(STAT_TRIALS);
+	}
+	StatAdd(STAT_STEPS, walked);
+	StatAdd(STAT_REJECTIONS, rejections);
+}
+
+void ReturnTrials(RandomWalk& walker, int steps, int trials, float& prob)
+{
+	std::vector<int> edges = { 1, steps + 1 };
+	std::vector<long long> counts;
+	ReturnTimeTrials(walker, edges, trials, counts);
+
+	prob = (float)counts[0] / (float)trials;
+}
+
+void NormalSimulation(int steps, RandomWalk rw, float& distance, float& range, int trials)
+{
+	NormalTrials(rw, steps, trials, distance, range);
+}
+
+void LoopErasedSimulation(int steps, RandomWalk rw, float& distance, float& largest_loop, float& erased_loop, int trials)
+{
+	LoopErasedTrials(rw, steps, trials, distance, largest_loop, erased_loop);
+}
+
+void ProbabilityToReturn(RandomWalk rw, float& prob, int steps, int trials)
+{
+	ReturnTrials(rw, steps, trials, prob);
+}
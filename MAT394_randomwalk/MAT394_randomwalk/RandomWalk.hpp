@@ -0,0 +1,127 @@
+/* Start Header -------------------------------------------------------
+File Name: RandomWalk.hpp
+Purpose: Random walk class and numerical simulations
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef RANDOMWALK_HPP
+#define RANDOMWALK_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+#include "SiteIndex.hpp"
+#include "StepDistribution.hpp"
+
+#define TRIALS 1000
+
+enum Direction {
+	X_UP,
+	Y_UP,
+	Z_UP,
+	X_DOWN,
+	Y_DOWN,
+	Z_DOWN
+};
+
+//how a step is drawn: one of the six lattice directions, or off the lattice
+//with Gaussian or heavy-tailed lengths, see ContinuousWalk.hpp
+enum WalkKernel {
+	KERNEL_LATTICE,
+	KERNEL_GAUSSIAN,
+	KERNEL_LEVY
+};
+
+class RandomWalk {
+
+public:
+	RandomWalk() {
+		points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+		points.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+		startPosition = points.front();
+		steps = 0;
+		looperased = false;
+		num_loop = 0;
+		size_loop = 0;
+		biggest_loop = 0;
+		loop_exist = false;
+		loop_start = 0;
+		keep_loop = false;
+		
+		limit = false;
+		limit_min = glm::vec3(-200, -200, -200);
+		limit_max = glm::vec3(200, 200, 200);
+
+		kernel = KERNEL_LATTICE;
+		alpha = 1.5f;
+		biased = false;
+		last_direction = STEP_FIRST;
+
+		rng.Seed(NextSeed());
+	}
+
+	void Walk();
+	void RemoveLast();
+	float Distance();
+	void Reset();
+	void CheckLoop();
+
+	
+	std::vector<glm::vec3> points;
+	int steps;
+	glm::vec3 startPosition;
+	glm::vec3 limit_min;
+	glm::vec3 limit_max;
+	bool limit;
+
+	//off-lattice steps; alpha is the tail exponent of a Levy flight
+	WalkKernel kernel;
+	float alpha;
+
+	//lattice steps drawn from bias instead of uniformly; last_direction is
+	//the walk's own last step, which loop erasure leaves alone
+	bool biased;
+	StepDistribution bias;
+	int last_direction;
+
+	//loop erased rw
+	bool looperased;
+	int num_loop;
+	int size_loop;
+	int biggest_loop;
+	bool loop_exist;
+	//after CheckLoop erased a loop it spanned points[loop_start] to the tip,
+	//size_loop steps; the vertices are only kept in loop with keep_loop
+	int loop_start;
+	bool keep_loop;
+	std::vector<glm::vec3> loop;
+	//step of every site on points, for CheckLoop
+	SiteIndex visited;
+	
+	Rng rng;
+
+};
+
+
+void NormalSimulation(int steps, RandomWalk rw, float& distance, float& range, int trials = TRIALS);
+void LoopErasedSimulation(int steps, RandomWalk rw, float& distance,float& largetst_loop, float& erased_loop, int trials = TRIALS);
+void ProbabilityToReturn(RandomWalk rw, float& prob, int steps, int trials = TRIALS);
+
+//range is the average number of distinct sites visited, start included
+void NormalTrials(RandomWalk& walker, int steps, int trials, float& distance, float& range);
+void LoopErasedTrials(RandomWalk& walker, int steps, int trials, float& distance, float& largest_loop, float& erased_loop);
+void ReturnTrials(RandomWalk& walker, int steps, int trials, float& prob);
+// Walks from the origin until the first return or edges.back() - 1 steps;
+// counts[i] is the number that came back at a step in [edges[i], edges[i+1]).
+// edges is increasing and starts at 1. Stretches away from the origin and
+// the walls are crossed in exact jumps, see FastForward.hpp; only walker's
+// box, bias and generator are used.
+void ReturnTimeTrials(RandomWalk& walker, const std::vector<int>& edges, int trials, std::vector<long long>& counts);
+
+#endif
@@ -0,0 +1,144 @@
+/* Start Header -------------------------------------------------------
+File Name: RangeTracker.cpp
+Purpose: Number of distinct sites a walk visits, kept step by step
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <vector>
+#include <algorithm>
+
+#include "RangeTracker.hpp"
+#include "EngineStats.hpp"
+
+#define EMPTY_KEY (~0ull)
+
+//brick coordinates are packed modulo 2^21, which keeps the bricks of any
+//walk of fewer than 2^23 steps apart
+#define COORD_MASK ((1u << 21) - 1)
+
+static uint64_t PackBrick(int x, int y, int z)
+{
+	return ((uint64_t)((uint32_t)(x >> 2) & COORD_MASK) << 42) | ((uint64_t)((uint32_t)(y >> 2) & COORD_MASK) << 21) | (uint64_t)((uint32_t)(z >> 2) & COORD_MASK);
+}
+
+RangeTracker::RangeTracker()
+{
+	count = 0;
+	dense = false;
+	for (int i = 0; i < 3; ++i)
+	{
+		box.origin[i] = 0;
+		box.size[i] = 0;
+	}
+	mask = 0;
+	shift = 64;
+	bricks = 0;
+	lastKey = EMPTY_KEY;
+	lastSlot = 0;
+}
+
+void RangeTracker::Begin(const RandomWalk& rw)
+{
+	//a short walk sets few words, clearing those beats clearing the box
+	for (size_t i = 0; i < touched.size(); ++i)
+		bits[touched[i]] = 0;
+	touched.clear();
+
+	DenseBox want;
+	dense = rw.limit && want.Set(rw.limit_min, rw.limit_max, RANGE_DENSE_SITES);
+	if (dense && !(want == box))
+	{
+		box = want;
+		bits.assign((size_t)(box.Sites() + 63) / 64, 0);
+		StatAdd(STAT_ALLOCATIONS);
+	}
+
+	if (!dense)
+	{
+		if (keys.empty())
+		{
+			keys.assign(256, EMPTY_KEY);
+			masks.assign(256, 0);
+			mask = keys.size() - 1;
+			shift = 56;
+		}
+		else if (bricks)
+			std::fill(keys.begin(), keys.end(), EMPTY_KEY);
+		bricks = 0;
+		lastKey = EMPTY_KEY;
+	}
+
+	count = 0;
+	Visit(rw.points.back());
+}
+
+void RangeTracker::Visit(const glm::vec3& site)
+{
+	if (dense)
+	{
+		size_t i = box.Offset(site);
+		uint64_t& word = bits[i >> 6];
+		uint64_t bit = 1ull << (i & 63);
+		if (!word)
+			touched.push_back((int)(i >> 6));
+		count += (word & bit) == 0;
+		word |= bit;
+		return;
+	}
+
+	int x = (int)site.x, y = (int)site.y, z = (int)site.z;
+	uint64_t key = PackBrick(x, y, z);
+	if (key != lastKey)
+	{
+		size_t i = (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift);
+		while (keys[i] != EMPTY_KEY && keys[i] != key)
+			i = (i + 1) & mask;
+		if (keys[i] == EMPTY_KEY)
+		{
+			keys[i] = key;
+			masks[i] = 0;
+			//at most half full
+			if (++bricks * 2 > keys.size())
+			{
+				Grow();
+				i = (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift);
+				while (keys[i] != key)
+					i = (i + 1) & mask;
+			}
+		}
+		lastKey = key;
+		lastSlot = i;
+	}
+
+	//a third of the steps revisit, too many to branch on
+	uint64_t bit = 1ull << (((z & 3) << 4) | ((y & 3) << 2) | (x & 3));
+	uint64_t& word = masks[lastSlot];
+	count += (word & bit) == 0;
+	word |= bit;
+}
+
+void RangeTracker::Grow()
+{
+	std::vector<uint64_t> oldKeys(keys.size() * 2, EMPTY_KEY);
+	std::vector<uint64_t> oldMasks(keys.size() * 2, 0);
+	oldKeys.swap(keys);
+	oldMasks.swap(masks);
+	mask = keys.size() - 1;
+	--shift;
+	StatAdd(STAT_ALLOCATIONS);
+
+	for (size_t j = 0; j < oldKeys.size(); ++j)
+	{
+		if (oldKeys[j] == EMPTY_KEY)
+			continue;
+		size_t i = (size_t)((oldKeys[j] * 0x9E3779B97F4A7C15ull) >> shift);
+		while (keys[i] != EMPTY_KEY)
+			i = (i + 1) & mask;
+		keys[i] = oldKeys[j];
+		masks[i] = oldMasks[j];
+	}
+}
@@ -0,0 +1,60 @@
+/* Start Header -------------------------------------------------------
+File Name: RangeTracker.hpp
+Purpose: Number of distinct sites a walk visits, kept step by step
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef RANGETRACKER_HPP
+#define RANGETRACKER_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "RandomWalk.hpp"
+#include "SiteIndex.hpp"
+
+//largest box, in sites, that gets a bitset (32 MB); bigger boxes hash
+#define RANGE_DENSE_SITES (1 << 28)
+
+// The range R_n of a walk. A walk in a box marks its sites in a bitset of
+// the box and clears only the words it set. An unbounded one keeps a hash
+// set of 4x4x4 bricks, each with a 64 bit mask of its visited sites; a step
+// mostly stays in the brick of the step before, which then costs one bit
+// test. Keep one tracker per thread, both stay allocated from trial to trial.
+class RangeTracker {
+public:
+	RangeTracker();
+
+	//forgets the last walk and visits the start of rw
+	void Begin(const RandomWalk& rw);
+	void Visit(const glm::vec3& site);
+	long long Count() const { return count; }
+
+private:
+	void Grow();
+
+	long long count;
+	bool dense;
+
+	//the box, for the bitset
+	DenseBox box;
+	std::vector<uint64_t> bits;
+	std::vector<int> touched;
+
+	//hash set of packed brick coordinates, and the brick of the last step
+	std::vector<uint64_t> keys;
+	std::vector<uint64_t> masks;
+	size_t mask;
+	int shift;
+	size_t bricks;
+	uint64_t lastKey;
+	size_t lastSlot;
+};
+
+#endif
@@ -0,0 +1,156 @@
+/* Start Header -------------------------------------------------------
+File Name: ResultCache.cpp
+Purpose: On-disk cache of completed trial chunks
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "ResultCache.hpp"
+
+static const char cacheMagic[4] = { 'R', 'W', 'C', '1' };
+
+// FNV-1a, only used to name the files; the full key is checked on load.
+unsigned long long HashKey(const std::string& key)
+{
+	unsigned long long hash = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < key.size(); ++i)
+	{
+		hash ^= (unsigned char)key[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+ResultCache::ResultCache()
+{
+	hits = 0;
+	misses = 0;
+}
+
+bool ResultCache::Open(const std::string& _directory)
+{
+#ifdef _WIN32
+	int result = _mkdir(_directory.c_str());
+#else
+	int result = mkdir(_directory.c_str(), 0755);
+#endif
+	if (result != 0 && errno != EEXIST)
+		return false;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	directory = _directory;
+	entries.clear();
+	return true;
+}
+
+std::string ResultCache::PathOf(const std::string& key) const
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.rwc", HashKey(key));
+	return directory + "/" + name;
+}
+
+// Called with the mutex held. A file whose header holds another key (a hash
+// collision) or is damaged is left alone and the key is simply not cached.
+ResultCache::Entry& ResultCache::Load(const std::string& key)
+{
+	std::map<std::string, Entry>::iterator found = entries.find(key);
+	if (found != entries.end())
+		return found->second;
+
+	Entry& entry = entries[key];
+	entry.usable = true;
+
+	FILE* file = fopen(PathOf(key).c_str(), "rb");
+	if (!file)
+		return entry;
+
+	char magic[4];
+	unsigned length = 0;
+	std::string stored;
+	if (fread(magic, 1, 4, file) == 4 && memcmp(magic, cacheMagic, 4) == 0 && fread(&length, 4, 1, file) == 1 && length < 4096)
+	{
+		stored.resize(length);
+		if (length && fread(&stored[0], 1, length, file) != length)
+			stored.clear();
+	}
+
+	if (stored != key)
+		entry.usable = false;
+	else
+	{
+		//a record cut short by a crash is dropped
+		CachedChunk chunk;
+		while (fread(&chunk, sizeof(chunk), 1, file) == 1)
+			entry.chunks.push_back(chunk);
+	}
+	fclose(file);
+	return entry;
+}
+
+bool ResultCache::Lookup(const std::string& key, int index, int trials, float* value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (directory.empty())
+		return false;
+
+	Entry& entry = Load(key);
+	for (size_t i = 0; i < entry.chunks.size(); ++i)
+	{
+		if (entry.chunks[i].index == index && entry.chunks[i].trials == trials)
+		{
+			memcpy(value, entry.chunks[i].value, sizeof(entry.chunks[i].value));
+			++hits;
+			return true;
+		}
+	}
+	++misses;
+	return false;
+}
+
+void ResultCache::Store(const std::string& key, int index, int trials, const float* value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (directory.empty())
+		return;
+
+	Entry& entry = Load(key);
+	if (!entry.usable)
+		return;
+
+	CachedChunk chunk;
+	chunk.index = index;
+	chunk.trials = trials;
+	memcpy(chunk.value, value, sizeof(chunk.value));
+
+	FILE* file = fopen(PathOf(key).c_str(), "ab");
+	if (!file)
+		return;
+	fseek(file, 0, SEEK_END);
+	if (ftell(file) == 0)
+	{
+		unsigned length = (unsigned)key.size();
+		fwrite(cacheMagic, 1, 4, file);
+		fwrite(&length, 4, 1, file);
+		fwrite(key.data(), 1, key.size(), file);
+	}
+	fwrite(&chunk, sizeof(chunk), 1, file);
+	fclose(file);
+	entry.chunks.push_back(chunk);
+}
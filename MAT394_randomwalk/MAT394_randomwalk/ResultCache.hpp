@@ -0,0 +1,67 @@
+/* Start Header -------------------------------------------------------
+File Name: ResultCache.hpp
+Purpose: On-disk cache of completed trial chunks
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+// Bump when a change to the engine alters the numbers a seed produces.
+#define CACHE_VERSION 6
+
+//outputs a data point carries at most, in column order
+#define POINT_VALUES 8
+
+struct CachedChunk {
+	int index;
+	int trials;
+	float value[POINT_VALUES];
+};
+
+// Every distinct configuration has a canonical key string (walk, box,
+// horizon, chunk size, seed, engine version). Its chunks live in
+// <directory>/<64 bit hash of the key>.rwc: a header with the full key, then
+// one record per finished chunk, appended as it completes. Asking for more
+// trials later only computes the chunks that are not in the file yet.
+class ResultCache {
+public:
+	ResultCache();
+
+	bool Open(const std::string& directory);
+	bool IsOpen() const { return !directory.empty(); }
+
+	bool Lookup(const std::string& key, int index, int trials, float* value);
+	void Store(const std::string& key, int index, int trials, const float* value);
+
+	std::atomic<int> hits;
+	std::atomic<int> misses;
+
+private:
+	struct Entry {
+		bool usable;
+		std::vector<CachedChunk> chunks;
+	};
+
+	Entry& Load(const std::string& key);
+	std::string PathOf(const std::string& key) const;
+
+	std::string directory;
+	std::map<std::string, Entry> entries;
+	std::mutex mutex;
+};
+
+unsigned long long HashKey(const std::string& key);
+
+#endif
@@ -0,0 +1,458 @@
+/* Start Header -------------------------------------------------------
+File Name: ResultSink.cpp
+Purpose: CSV and Arrow IPC result sinks
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "ResultSink.hpp"
+
+ResultSink::ResultSink()
+{
+	file = NULL;
+	rows = 0;
+}
+
+ResultSink::~ResultSink()
+{
+	if (file)
+		fclose(file);
+}
+
+bool ResultSink::Open(const std::string& path, const std::vector<ResultColumn>& _columns, const RunMetadata& _meta)
+{
+	file = fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+
+	columns = _columns;
+	meta = _meta;
+	rows = 0;
+	batch.assign(columns.size(), std::vector<double>());
+	for (size_t c = 0; c < batch.size(); ++c)
+		batch[c].reserve(SINK_BATCH_ROWS);
+	start = std::chrono::steady_clock::now();
+
+	if (!WriteHeader())
+	{
+		fclose(file);
+		file = NULL;
+		return false;
+	}
+	return true;
+}
+
+void ResultSink::Append(const double* row)
+{
+	if (!file)
+		return;
+
+	for (size_t c = 0; c < columns.size(); ++c)
+		batch[c].push_back(row[c]);
+	++rows;
+
+	if (rows == SINK_BATCH_ROWS)
+	{
+		WriteBatch();
+		for (size_t c = 0; c < batch.size(); ++c)
+			batch[c].clear();
+		rows = 0;
+	}
+}
+
+// Writes the rows so far as their own batch, for slow streams that should
+// be readable before the run ends.
+void ResultSink::Flush()
+{
+	if (!file)
+		return;
+
+	if (rows)
+	{
+		WriteBatch();
+		for (size_t c = 0; c < batch.size(); ++c)
+			batch[c].clear();
+		rows = 0;
+	}
+	fflush(file);
+}
+
+void ResultSink::Close()
+{
+	if (!file)
+		return;
+
+	if (rows)
+		WriteBatch();
+	rows = 0;
+
+	double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	WriteFooter(wall_time);
+	fclose(file);
+	file = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////// CSV
+
+bool CsvSink::WriteHeader()
+{
+	fprintf(file, "# experiment: %s\n# lattice: %s\n# box: %s\n# seed: %llu\n# trials: %i\n",
+		meta.experiment.c_str(), meta.lattice.c_str(), meta.box.c_str(), meta.seed, meta.trials);
+	for (size_t i = 0; i < meta.extra.size(); ++i)
+		fprintf(file, "# %s: %s\n", meta.extra[i].first.c_str(), meta.extra[i].second.c_str());
+	for (size_t c = 0; c < columns.size(); ++c)
+		fprintf(file, "%s%s", c ? "," : "", columns[c].name.c_str());
+	fprintf(file, "\n");
+	return true;
+}
+
+bool CsvSink::WriteBatch()
+{
+	//format the whole batch first so the file gets one write
+	std::string text;
+	text.reserve(rows * columns.size() * 16);
+	char cell[32];
+	for (size_t r = 0; r < rows; ++r)
+	{
+		for (size_t c = 0; c < columns.size(); ++c)
+		{
+			if (columns[c].type == COLUMN_INT64)
+				snprintf(cell, sizeof(cell), "%s%lld", c ? "," : "", (long long)batch[c][r]);
+			else
+				snprintf(cell, sizeof(cell), "%s%.9g", c ? "," : "", batch[c][r]);
+			text += cell;
+		}
+		text += '\n';
+	}
+	return fwrite(text.data(), 1, text.size(), file) == text.size();
+}
+
+bool CsvSink::WriteFooter(double wall_time)
+{
+	fprintf(file, "# wall_time_s: %.6f\n", wall_time);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////// FLATBUFFERS
+
+// Just enough of a FlatBuffers writer for the Arrow metadata. Objects are
+// written front to back and offsets patched once their target exists, so
+// every offset points forward as the format requires.
+struct FbSlot {
+	int id;
+	int size;
+	long long value;
+};
+
+class FlatBuffer {
+public:
+	std::vector<unsigned char> data;
+
+	void Pad(size_t alignment)
+	{
+		while (data.size() % alignment)
+			data.push_back(0);
+	}
+
+	void Put(const void* bytes, size_t size)
+	{
+		const unsigned char* p = (const unsigned char*)bytes;
+		data.insert(data.end(), p, p + size);
+	}
+
+	template <typename T>
+	void Put(T value)
+	{
+		Put(&value, sizeof(T));
+	}
+
+	// Writes a table and its vtable. where[i] receives the position of
+	// slots[i], for linking offset slots later.
+	size_t Table(std::vector<FbSlot> slots, std::vector<size_t>& where)
+	{
+		int count = 0;
+		for (size_t i = 0; i < slots.size(); ++i)
+			count = std::max(count, slots[i].id + 1);
+
+		//largest fields first keeps padding down
+		std::vector<size_t> order(slots.size());
+		for (size_t i = 0; i < order.size(); ++i)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&slots](size_t a, size_t b) { return slots[a].size > slots[b].size; });
+
+		Pad(2);
+		size_t vtable = data.size();
+		size_t table = vtable + 4 + 2 * count;
+		while (table % 8)
+			table += 2;
+
+		std::vector<size_t> offset(slots.size());
+		size_t pos = table + 4;
+		for (size_t k = 0; k < order.size(); ++k)
+		{
+			int size = slots[order[k]].size;
+			while (pos % size)
+				++pos;
+			offset[order[k]] = pos - table;
+			pos += size;
+		}
+
+		std::vector<unsigned short> entries(count, 0);
+		for (size_t i = 0; i < slots.size(); ++i)
+			entries[slots[i].id] = (unsigned short)offset[i];
+		Put((unsigned short)(4 + 2 * count));
+		Put((unsigned short)(pos - table));
+		for (int i = 0; i < count; ++i)
+			Put(entries[i]);
+		while (data.size() < table)
+			data.push_back(0);
+
+		Put((int)(table - vtable));
+		data.resize(pos, 0);
+		where.resize(slots.size());
+		for (size_t i = 0; i < slots.size(); ++i)
+		{
+			where[i] = table + offset[i];
+			memcpy(&data[where[i]], &slots[i].value, slots[i].size);
+		}
+		return table;
+	}
+
+	size_t String(const std::string& text)
+	{
+		Pad(4);
+		size_t at = data.size();
+		Put((unsigned)text.size());
+		Put(text.data(), text.size() + 1);
+		return at;
+	}
+
+	// Structs inside a vector are aligned to 8 in all the Arrow tables.
+	size_t StructVector(const void* bytes, int count, int size)
+	{
+		while ((data.size() + 4) % 8)
+			data.push_back(0);
+		size_t at = data.size();
+		Put((unsigned)count);
+		Put(bytes, (size_t)count * size);
+		return at;
+	}
+
+	size_t OffsetVector(int count, std::vector<size_t>& where)
+	{
+		Pad(4);
+		size_t at = data.size();
+		Put((unsigned)count);
+		where.resize(count);
+		for (int i = 0; i < count; ++i)
+		{
+			where[i] = data.size();
+			Put((unsigned)0);
+		}
+		return at;
+	}
+
+	void Link(size_t where, size_t target)
+	{
+		unsigned offset = (unsigned)(target - where);
+		memcpy(&data[where], &offset, 4);
+	}
+};
+
+//////////////////////////////////////////////////////////////////// ARROW
+
+#define ARROW_V5 4
+#define ARROW_HEADER_SCHEMA 1
+#define ARROW_HEADER_RECORDBATCH 3
+#define ARROW_TYPE_INT 2
+#define ARROW_TYPE_FLOATINGPOINT 3
+#define ARROW_PRECISION_DOUBLE 2
+
+static const char arrowMagic[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+
+static void ArrowKeyValues(FlatBuffer& fb, size_t link, const std::vector<std::pair<std::string, std::string>>& pairs)
+{
+	std::vector<size_t> items, where;
+	fb.Link(link, fb.OffsetVector((int)pairs.size(), items));
+	for (size_t i = 0; i < pairs.size(); ++i)
+	{
+		fb.Link(items[i], fb.Table({ { 0, 4, 0 }, { 1, 4, 0 } }, where));
+		std::vector<size_t> slots = where;
+		fb.Link(slots[0], fb.String(pairs[i].first));
+		fb.Link(slots[1], fb.String(pairs[i].second));
+	}
+}
+
+static void ArrowSchema(FlatBuffer& fb, size_t link, const std::vector<ResultColumn>& columns,
+	const std::vector<std::pair<std::string, std::string>>& metadata)
+{
+	std::vector<size_t> where, fields;
+	fb.Link(link, fb.Table({ { 1, 4, 0 }, { 2, 4, 0 } }, where));
+	size_t metadataSlot = where[1];
+
+	fb.Link(where[0], fb.OffsetVector((int)columns.size(), fields));
+	for (size_t c = 0; c < columns.size(); ++c)
+	{
+		bool integer = columns[c].type == COLUMN_INT64;
+		std::vector<size_t> slots, children;
+		fb.Link(fields[c], fb.Table({ { 0, 4, 0 }, { 1, 1, 0 },
+			{ 2, 1, integer ? ARROW_TYPE_INT : ARROW_TYPE_FLOATINGPOINT }, { 3, 4, 0 }, { 5, 4, 0 } }, slots));
+		fb.Link(slots[0], fb.String(columns[c].name));
+
+		std::vector<size_t> type;
+		if (integer)
+			fb.Link(slots[3], fb.Table({ { 0, 4, 64 }, { 1, 1, 1 } }, type));
+		else
+			fb.Link(slots[3], fb.Table({ { 0, 2, ARROW_PRECISION_DOUBLE } }, type));
+
+		//readers insist on a children vector, even an empty one
+		fb.Link(slots[4], fb.OffsetVector(0, children));
+	}
+
+	ArrowKeyValues(fb, metadataSlot, metadata);
+}
+
+static std::vector<std::pair<std::string, std::string>> ArrowMetadata(const RunMetadata& meta)
+{
+	std::vector<std::pair<std::string, std::string>> pairs;
+	pairs.push_back(std::make_pair("experiment", meta.experiment));
+	pairs.push_back(std::make_pair("lattice", meta.lattice));
+	pairs.push_back(std::make_pair("box", meta.box));
+	pairs.push_back(std::make_pair("seed", std::to_string(meta.seed)));
+	pairs.push_back(std::make_pair("trials", std::to_string(meta.trials)));
+	pairs.insert(pairs.end(), meta.extra.begin(), meta.extra.end());
+	return pairs;
+}
+
+// Continuation marker, metadata size, then the flatbuffer padded to 8.
+static int WriteMessage(FILE* file, FlatBuffer& fb)
+{
+	fb.Pad(8);
+	int size = (int)fb.data.size();
+	unsigned continuation = 0xFFFFFFFF;
+	fwrite(&continuation, 4, 1, file);
+	fwrite(&size, 4, 1, file);
+	fwrite(fb.data.data(), 1, fb.data.size(), file);
+	return 8 + size;
+}
+
+bool ArrowSink::WriteHeader()
+{
+	blocks.clear();
+	fwrite(arrowMagic, 1, 8, file);
+
+	FlatBuffer fb;
+	std::vector<size_t> where;
+	fb.Put((unsigned)0);
+	fb.Link(0, fb.Table({ { 0, 2, ARROW_V5 }, { 1, 1, ARROW_HEADER_SCHEMA }, { 2, 4, 0 }, { 3, 8, 0 } }, where));
+	ArrowSchema(fb, where[2], columns, ArrowMetadata(meta));
+
+	position = 8 + WriteMessage(file, fb);
+	return !ferror(file);
+}
+
+bool ArrowSink::WriteBatch()
+{
+	struct FieldNode { long long length, null_count; };
+	struct Buffer { long long offset, length; };
+
+	//no nulls, so every validity bitmap is an empty buffer
+	std::vector<FieldNode> nodes;
+	std::vector<Buffer> buffers;
+	long long body = 0;
+	for (size_t c = 0; c < columns.size(); ++c)
+	{
+		FieldNode node = { (long long)rows, 0 };
+		nodes.push_back(node);
+		Buffer validity = { body, 0 };
+		Buffer values = { body, (long long)rows * 8 };
+		buffers.push_back(validity);
+		buffers.push_back(values);
+		body += ((long long)rows * 8 + 7) / 8 * 8;
+	}
+
+	FlatBuffer fb;
+	std::vector<size_t> where, batchSlots;
+	fb.Put((unsigned)0);
+	fb.Link(0, fb.Table({ { 0, 2, ARROW_V5 }, { 1, 1, ARROW_HEADER_RECORDBATCH }, { 2, 4, 0 }, { 3, 8, body } }, where));
+	fb.Link(where[2], fb.Table({ { 0, 8, (long long)rows }, { 1, 4, 0 }, { 2, 4, 0 } }, batchSlots));
+	std::vector<size_t> slots = batchSlots;
+	fb.Link(slots[1], fb.StructVector(nodes.data(), (int)nodes.size(), sizeof(FieldNode)));
+	fb.Link(slots[2], fb.StructVector(buffers.data(), (int)buffers.size(), sizeof(Buffer)));
+
+	Block block;
+	block.offset = position;
+	block.metaDataLength = WriteMessage(file, fb);
+	block.bodyLength = body;
+	blocks.push_back(block);
+
+	std::vector<long long> ints;
+	for (size_t c = 0; c < columns.size(); ++c)
+	{
+		if (columns[c].type == COLUMN_INT64)
+		{
+			ints.resize(rows);
+			for (size_t r = 0; r < rows; ++r)
+				ints[r] = (long long)batch[c][r];
+			fwrite(ints.data(), 8, rows, file);
+		}
+		else
+			fwrite(batch[c].data(), 8, rows, file);
+	}
+
+	position += block.metaDataLength + body;
+	return !ferror(file);
+}
+
+bool ArrowSink::WriteFooter(double wall_time)
+{
+	//end-of-stream marker, then the footer the file readers start from
+	unsigned eos[2] = { 0xFFFFFFFF, 0 };
+	fwrite(eos, 4, 2, file);
+
+	std::vector<std::pair<std::string, std::string>> metadata = ArrowMetadata(meta);
+	metadata.push_back(std::make_pair("wall_time_s", std::to_string(wall_time)));
+
+	FlatBuffer fb;
+	std::vector<size_t> where, dictionaries;
+	fb.Put((unsigned)0);
+	fb.Link(0, fb.Table({ { 0, 2, ARROW_V5 }, { 1, 4, 0 }, { 2, 4, 0 }, { 3, 4, 0 } }, where));
+	std::vector<size_t> slots = where;
+	ArrowSchema(fb, slots[1], columns, metadata);
+	fb.Link(slots[2], fb.OffsetVector(0, dictionaries));
+
+	struct FbBlock { long long offset; int metaDataLength; int pad; long long bodyLength; };
+	std::vector<FbBlock> fbBlocks;
+	for (size_t i = 0; i < blocks.size(); ++i)
+	{
+		FbBlock b = { blocks[i].offset, blocks[i].metaDataLength, 0, blocks[i].bodyLength };
+		fbBlocks.push_back(b);
+	}
+	fb.Link(slots[3], fb.StructVector(fbBlocks.data(), (int)fbBlocks.size(), sizeof(FbBlock)));
+
+	int size = (int)fb.data.size();
+	fwrite(fb.data.data(), 1, fb.data.size(), file);
+	fwrite(&size, 4, 1, file);
+	fwrite(arrowMagic, 1, 6, file);
+	return !ferror(file);
+}
+
+ResultSink* CreateResultSink(const std::string& path)
+{
+	size_t dot = path.find_last_of('.');
+	std::string extension = dot == std::string::npos ? "" : path.substr(dot);
+	if (extension == ".arrow" || extension == ".feather")
+		return new ArrowSink;
+	return new CsvSink;
+}
@@ -0,0 +1,105 @@
+/* Start Header -------------------------------------------------------
+File Name: ResultSink.hpp
+Purpose: Streaming export of simulation results to Arrow IPC or CSV
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef RESULTSINK_HPP
+#define RESULTSINK_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+
+#define SINK_BATCH_ROWS 65536
+
+enum ColumnType {
+	COLUMN_INT64,
+	COLUMN_FLOAT64
+};
+
+struct ResultColumn {
+	std::string name;
+	ColumnType type;
+};
+
+struct RunMetadata {
+	std::string experiment;
+	std::string lattice;
+	std::string box;
+	unsigned long long seed;
+	int trials;
+	std::vector<std::pair<std::string, std::string>> extra;
+};
+
+// Rows are kept column by column and written a whole batch at a time, so
+// Append is only a few stores and the file sees one write per batch.
+class ResultSink {
+public:
+	ResultSink();
+	virtual ~ResultSink();
+
+	bool Open(const std::string& path, const std::vector<ResultColumn>& columns, const RunMetadata& meta);
+	void Append(const double* row);
+	void Flush();
+	void Close();
+	bool IsOpen() const { return file != NULL; }
+
+	//the wall time is counted from Open unless the run started earlier
+	void SetStart(std::chrono::steady_clock::time_point time) { start = time; }
+
+protected:
+	virtual bool WriteHeader() = 0;
+	virtual bool WriteBatch() = 0;
+	virtual bool WriteFooter(double wall_time) = 0;
+
+	FILE* file;
+	std::vector<ResultColumn> columns;
+	RunMetadata meta;
+	std::vector<std::vector<double>> batch;
+	size_t rows;
+	std::chrono::steady_clock::time_point start;
+};
+
+class CsvSink : public ResultSink {
+public:
+	~CsvSink() { Close(); }
+
+protected:
+	bool WriteHeader();
+	bool WriteBatch();
+	bool WriteFooter(double wall_time);
+};
+
+// Arrow IPC file format (what pyarrow.ipc.open_file and Feather v2 read):
+// schema message, one record batch message per batch, then a footer
+// listing the batches. The run metadata is schema custom_metadata.
+class ArrowSink : public ResultSink {
+public:
+	~ArrowSink() { Close(); }
+
+protected:
+	bool WriteHeader();
+	bool WriteBatch();
+	bool WriteFooter(double wall_time);
+
+	struct Block {
+		long long offset;
+		int metaDataLength;
+		long long bodyLength;
+	};
+	std::vector<Block> blocks;
+	long long position;
+};
+
+// .arrow and .feather get an ArrowSink, anything else a CsvSink.
+ResultSink* CreateResultSink(const std::string& path);
+
+#endif
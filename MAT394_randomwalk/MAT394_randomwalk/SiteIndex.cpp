@@ -0,0 +1,180 @@
+/* Start Header -------------------------------------------------------
+File Name: SiteIndex.cpp
+Purpose: Site -> step index of a walk's path, dense in a box or hashed
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "SiteIndex.hpp"
+#include "EngineStats.hpp"
+
+#define EMPTY_KEY (~0ull)
+
+//coordinates are packed modulo 2^21, which keeps the sites of any path
+//shorter than 2^21 steps apart
+#define COORD_MASK ((1u << 21) - 1)
+
+static uint64_t PackSite(const glm::vec3& site)
+{
+	return ((uint64_t)((uint32_t)(int)site.x & COORD_MASK) << 42) | ((uint64_t)((uint32_t)(int)site.y & COORD_MASK) << 21) | (uint64_t)((uint32_t)(int)site.z & COORD_MASK);
+}
+
+bool DenseBox::Set(const glm::vec3& limit_min, const glm::vec3& limit_max, long long max_sites)
+{
+	for (int a = 0; a < 3; ++a)
+	{
+		origin[a] = (int)ceil(limit_min[a]);
+		size[a] = std::max((int)floor(limit_max[a]) - origin[a] + 1, 1);
+	}
+	return Sites() <= max_sites;
+}
+
+bool DenseBox::operator==(const DenseBox& other) const
+{
+	for (int a = 0; a < 3; ++a)
+	{
+		if (origin[a] != other.origin[a] || size[a] != other.size[a])
+			return false;
+	}
+	return true;
+}
+
+SiteIndex::SiteIndex()
+{
+	ready = false;
+	dense = false;
+	for (int a = 0; a < 3; ++a)
+	{
+		box.origin[a] = 0;
+		box.size[a] = 0;
+	}
+	mask = 0;
+	used = 0;
+	shift = 64;
+}
+
+void SiteIndex::Build(const std::vector<glm::vec3>& path, int first, int last, bool limit, const glm::vec3& limit_min, const glm::vec3& limit_max)
+{
+	Clear();
+
+	//a box changed while the walk was in it can leave the path outside
+	DenseBox want;
+	dense = limit && want.Set(limit_min, limit_max, INDEX_DENSE_SITES);
+	for (int i = first; i <= last && dense; ++i)
+		dense = want.Contains(path[i]);
+
+	if (dense && !(want == box))
+	{
+		box = want;
+		steps.assign((size_t)box.Sites(), -1);
+		pageTouched.assign((size_t)(box.Sites() + INDEX_PAGE - 1) / INDEX_PAGE, 0);
+		touched.clear();
+		StatAdd(STAT_ALLOCATIONS);
+	}
+	if (!dense && keys.empty())
+	{
+		keys.assign(1024, EMPTY_KEY);
+		values.assign(1024, -1);
+		mask = keys.size() - 1;
+		shift = 54;
+	}
+
+	//backwards, so a site on the path twice keeps its first step
+	ready = true;
+	for (int i = last; i >= first; --i)
+		Set(path[i], i);
+}
+
+void SiteIndex::Clear()
+{
+	for (size_t p = 0; p < touched.size(); ++p)
+	{
+		size_t start = (size_t)touched[p] * INDEX_PAGE;
+		std::fill(steps.begin() + start, steps.begin() + std::min(start + INDEX_PAGE, steps.size()), -1);
+		pageTouched[touched[p]] = 0;
+	}
+	touched.clear();
+
+	if (used)
+	{
+		std::fill(keys.begin(), keys.end(), EMPTY_KEY);
+		used = 0;
+	}
+	ready = false;
+}
+
+int SiteIndex::Find(const glm::vec3& site) const
+{
+	if (dense)
+		return steps[box.Offset(site)];
+
+	uint64_t key = PackSite(site);
+	for (size_t i = (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift); keys[i] != EMPTY_KEY; i = (i + 1) & mask)
+	{
+		if (keys[i] == key)
+			return values[i];
+	}
+	return -1;
+}
+
+void SiteIndex::Set(const glm::vec3& site, int step)
+{
+	if (dense)
+	{
+		size_t i = box.Offset(site);
+		size_t page = i / INDEX_PAGE;
+		if (!pageTouched[page])
+		{
+			pageTouched[page] = 1;
+			touched.push_back((int)page);
+		}
+		steps[i] = step;
+		return;
+	}
+
+	uint64_t key = PackSite(site);
+	size_t i = (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift);
+	while (keys[i] != EMPTY_KEY && keys[i] != key)
+		i = (i + 1) & mask;
+	if (keys[i] == EMPTY_KEY)
+	{
+		keys[i] = key;
+		//at most half full
+		if (++used * 2 > keys.size())
+		{
+			Grow();
+			Set(site, step);
+			return;
+		}
+	}
+	values[i] = step;
+}
+
+void SiteIndex::Grow()
+{
+	std::vector<uint64_t> oldKeys(keys.size() * 2, EMPTY_KEY);
+	std::vector<int> oldValues(keys.size() * 2, -1);
+	oldKeys.swap(keys);
+	oldValues.swap(values);
+	mask = keys.size() - 1;
+	--shift;
+	StatAdd(STAT_ALLOCATIONS);
+
+	for (size_t j = 0; j < oldKeys.size(); ++j)
+	{
+		if (oldKeys[j] == EMPTY_KEY)
+			continue;
+		size_t i = (size_t)((oldKeys[j] * 0x9E3779B97F4A7C15ull) >> shift);
+		while (keys[i] != EMPTY_KEY)
+			i = (i + 1) & mask;
+		keys[i] = oldKeys[j];
+		values[i] = oldValues[j];
+	}
+}
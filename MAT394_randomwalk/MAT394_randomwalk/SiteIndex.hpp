@@ -0,0 +1,87 @@
+/* Start Header -------------------------------------------------------
+File Name: SiteIndex.hpp
+Purpose: Site -> step index of a walk's path, dense in a box or hashed
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef SITEINDEX_HPP
+#define SITEINDEX_HPP
+
+#include <stdint.h>
+#include <vector>
+#include <glm/glm.hpp>
+
+//largest box, in sites, that gets an int per site (32 MB); a 201^3 box,
+//the largest the window's sliders make, fits
+#define INDEX_DENSE_SITES (1 << 23)
+
+//sites per page of the dense index; a trial clears only the pages it wrote
+#define INDEX_PAGE 1024
+
+// The lattice sites inside [limit_min, limit_max], x running fastest.
+struct DenseBox {
+	int origin[3];
+	int size[3];
+
+	//false if the box has more than max_sites sites
+	bool Set(const glm::vec3& limit_min, const glm::vec3& limit_max, long long max_sites);
+	long long Sites() const { return (long long)size[0] * size[1] * size[2]; }
+	bool Contains(const glm::vec3& site) const
+	{
+		return (unsigned)((int)site.x - origin[0]) < (unsigned)size[0] && (unsigned)((int)site.y - origin[1]) < (unsigned)size[1]
+			&& (unsigned)((int)site.z - origin[2]) < (unsigned)size[2];
+	}
+	size_t Offset(const glm::vec3& site) const
+	{
+		return ((size_t)((int)site.z - origin[2]) * size[1] + ((int)site.y - origin[1])) * size[0] + ((int)site.x - origin[0]);
+	}
+	bool operator==(const DenseBox& other) const;
+};
+
+// Where on the path each site is, so loop detection costs O(1) per step
+// instead of a scan of the path. Entries are never removed when a loop is
+// erased; the caller trusts an entry only if the path still holds that site
+// at that step. A copy starts out empty and is built again from the path
+// when first used, so copying a walk does not copy the index.
+class SiteIndex {
+public:
+	SiteIndex();
+	SiteIndex(const SiteIndex&) : SiteIndex() {}
+	SiteIndex& operator=(const SiteIndex&) { Clear(); return *this; }
+
+	//indexes path[first..last], dense if the box holds all of it
+	void Build(const std::vector<glm::vec3>& path, int first, int last, bool limit, const glm::vec3& limit_min, const glm::vec3& limit_max);
+	//forgets the path, touching only the pages it wrote
+	void Clear();
+	bool Ready() const { return ready; }
+	bool Covers(const glm::vec3& site) const { return !dense || box.Contains(site); }
+
+	//last step stored for site, or -1
+	int Find(const glm::vec3& site) const;
+	void Set(const glm::vec3& site, int step);
+
+private:
+	void Grow();
+
+	bool ready;
+	bool dense;
+
+	DenseBox box;
+	std::vector<int> steps;
+	std::vector<int> touched;
+	std::vector<unsigned char> pageTouched;
+
+	//open addressing on packed coordinates
+	std::vector<uint64_t> keys;
+	std::vector<int> values;
+	size_t mask;
+	size_t used;
+	int shift;
+};
+
+#endif
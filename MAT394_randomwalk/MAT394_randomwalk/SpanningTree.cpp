@@ -0,0 +1,255 @@
+/* Start Header -------------------------------------------------------
+File Name: SpanningTree.cpp
+Purpose: Wilson's algorithm, tree statistics and tree files
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "SpanningTree.hpp"
+#include "EngineStats.hpp"
+#include "LoopHistograms.hpp"
+#include "Trace.hpp"
+
+//the order of Direction, TREE_ROOT last
+static const int StepX[7] = { 1, 0, 0, -1, 0, 0, 0 };
+static const int StepY[7] = { 0, 1, 0, 0, -1, 0, 0 };
+static const int StepZ[7] = { 0, 0, 1, 0, 0, -1, 0 };
+
+SpanningTree::SpanningTree()
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		size[i] = 0;
+		bricks[i] = 0;
+	}
+	rng.Seed(NextSeed());
+}
+
+void SpanningTree::SetBox(int nx, int ny, int nz)
+{
+	size[0] = nx;
+	size[1] = ny;
+	size[2] = nz;
+	for (int i = 0; i < 3; ++i)
+		bricks[i] = (size[i] + TREE_BRICK - 1) / TREE_BRICK;
+
+	size_t padded = (size_t)bricks[0] * bricks[1] * bricks[2] * TREE_BRICK * TREE_BRICK * TREE_BRICK;
+	parent.assign(padded, TREE_ROOT);
+	inTree.assign((padded + 63) / 64, 0);
+	branches.clear();
+}
+
+glm::vec3 SpanningTree::Point(int x, int y, int z) const
+{
+	return glm::vec3(x - size[0] / 2, y - size[1] / 2, z - size[2] / 2);
+}
+
+void SpanningTree::Sample()
+{
+	TRACE_ZONE("SpanningTree");
+	std::fill(inTree.begin(), inTree.end(), 0);
+	branches.clear();
+
+	int root = Index(0, 0, 0);
+	parent[root] = TREE_ROOT;
+	inTree[root >> 6] |= 1ull << (root & 63);
+
+	long long steps = 0;
+	long long rejections = 0;
+	for (int z0 = 0; z0 < size[2]; ++z0)
+	{
+		for (int y0 = 0; y0 < size[1]; ++y0)
+		{
+			for (int x0 = 0; x0 < size[0]; ++x0)
+			{
+				int site = Index(x0, y0, z0);
+				if (InTree(site))
+					continue;
+
+				//walk until the tree, a later exit from a site replaces the
+				//earlier one, which is what erases the loops
+				int x = x0, y = y0, z = z0;
+				while (!InTree(site))
+				{
+					int d = rng.Below(6);
+					int nx = x + StepX[d], ny = y + StepY[d], nz = z + StepZ[d];
+					if ((unsigned)nx >= (unsigned)size[0] || (unsigned)ny >= (unsigned)size[1] || (unsigned)nz >= (unsigned)size[2])
+					{
+						++rejections;
+						continue;
+					}
+					parent[site] = (unsigned char)d;
+					x = nx;
+					y = ny;
+					z = nz;
+					site = Index(x, y, z);
+					++steps;
+				}
+
+				//retrace the loop-erased path and add it to the tree
+				x = x0;
+				y = y0;
+				z = z0;
+				site = Index(x, y, z);
+				int length = 0;
+				while (!InTree(site))
+				{
+					inTree[site >> 6] |= 1ull << (site & 63);
+					int d = parent[site];
+					x += StepX[d];
+					y += StepY[d];
+					z += StepZ[d];
+					site = Index(x, y, z);
+					++length;
+				}
+				branches.push_back(length);
+				HistAdd(HIST_BRANCH_LENGTH, length);
+			}
+		}
+	}
+
+	StatAdd(STAT_STEPS, steps);
+	StatAdd(STAT_REJECTIONS, rejections);
+}
+
+void SpanningTree::Degrees(std::vector<unsigned char>& degree) const
+{
+	degree.assign(parent.size(), 0);
+	for (int z = 0; z < size[2]; ++z)
+	{
+		for (int y = 0; y < size[1]; ++y)
+		{
+			for (int x = 0; x < size[0]; ++x)
+			{
+				int site = Index(x, y, z);
+				int d = parent[site];
+				if (d == TREE_ROOT)
+					continue;
+				++degree[site];
+				++degree[Index(x + StepX[d], y + StepY[d], z + StepZ[d])];
+			}
+		}
+	}
+}
+
+void SpanningTree::Edges(std::vector<glm::vec3>& lines) const
+{
+	lines.clear();
+	for (int z = 0; z < size[2]; ++z)
+	{
+		for (int y = 0; y < size[1]; ++y)
+		{
+			for (int x = 0; x < size[0]; ++x)
+			{
+				int d = parent[Index(x, y, z)];
+				if (d == TREE_ROOT)
+					continue;
+				lines.push_back(Point(x, y, z));
+				lines.push_back(Point(x + StepX[d], y + StepY[d], z + StepZ[d]));
+			}
+		}
+	}
+}
+
+bool SpanningTree::Write(const std::string& path) const
+{
+	FILE* file = fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+
+	int header[3] = { size[0], size[1], size[2] };
+	bool ok = fwrite("RWT1", 1, 4, file) == 4 && fwrite(header, sizeof(header), 1, file) == 1;
+	std::vector<unsigned char> row(size[0]);
+	for (int z = 0; z < size[2] && ok; ++z)
+	{
+		for (int y = 0; y < size[1] && ok; ++y)
+		{
+			for (int x = 0; x < size[0]; ++x)
+				row[x] = parent[Index(x, y, z)];
+			ok = fwrite(row.data(), 1, row.size(), file) == row.size();
+		}
+	}
+	return fclose(file) == 0 && ok;
+}
+
+bool SpanningTree::Read(const std::string& path)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+
+	char magic[4];
+	int header[3];
+	bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, "RWT1", 4) == 0
+		&& fread(header, sizeof(header), 1, file) == 1
+		&& header[0] > 0 && header[1] > 0 && header[2] > 0 && header[0] <= 1024 && header[1] <= 1024 && header[2] <= 1024;
+	if (ok)
+	{
+		SetBox(header[0], header[1], header[2]);
+		std::vector<unsigned char> row(size[0]);
+		for (int z = 0; z < size[2] && ok; ++z)
+		{
+			for (int y = 0; y < size[1] && ok; ++y)
+			{
+				ok = fread(row.data(), 1, row.size(), file) == row.size();
+				for (int x = 0; x < size[0] && ok; ++x)
+				{
+					ok = row[x] <= TREE_ROOT;
+					parent[Index(x, y, z)] = row[x];
+				}
+			}
+		}
+	}
+	fclose(file);
+	return ok;
+}
+
+void TreeTrials(SpanningTree& tree, int n, int trials, float& branch, float& leaves, float& branch_points)
+{
+	TRACE_ZONE("TreeTrials");
+	StatBusy busy;
+	if (tree.size[0] != n || tree.size[1] != n || tree.size[2] != n)
+		tree.SetBox(n, n, n);
+
+	double branch_sum = 0.0;
+	long long leaf_count = 0;
+	long long branch_point_count = 0;
+	std::vector<unsigned char> degree;
+	for (int i = 0; i < trials; ++i)
+	{
+		tree.Sample();
+		long long length = 0;
+		for (size_t b = 0; b < tree.branches.size(); ++b)
+			length += tree.branches[b];
+		branch_sum += tree.branches.empty() ? 0.0 : (double)length / tree.branches.size();
+
+		tree.Degrees(degree);
+		for (int z = 0; z < n; ++z)
+		{
+			for (int y = 0; y < n; ++y)
+			{
+				for (int x = 0; x < n; ++x)
+				{
+					int d = degree[tree.Index(x, y, z)];
+					HistAdd(HIST_TREE_DEGREE, d);
+					leaf_count += d == 1;
+					branch_point_count += d >= 3;
+				}
+			}
+		}
+		StatAdd(STAT_TRIALS);
+	}
+
+	double sites = (double)n * n * n * trials;
+	branch = (float)(branch_sum / trials);
+	leaves = (float)(leaf_count / sites);
+	branch_points = (float)(branch_point_count / sites);
+}
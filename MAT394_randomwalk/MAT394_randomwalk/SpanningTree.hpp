@@ -0,0 +1,77 @@
+/* Start Header -------------------------------------------------------
+File Name: SpanningTree.hpp
+Purpose: Uniform spanning trees of a lattice box by Wilson's algorithm
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef SPANNINGTREE_HPP
+#define SPANNINGTREE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+
+//parent direction of the root, the others use Direction
+#define TREE_ROOT 6
+
+//sites are stored in 4x4x4 bricks, so a walk stays on a few cache lines
+//for several steps in every direction; Index is written for 4
+#define TREE_BRICK 4
+
+// Wilson's algorithm: a walk from every site not yet in the tree until it
+// hits the tree, then its loop erasure joins the tree as a branch. The loop
+// erasure is implicit, each site keeps the direction it was last left by,
+// so the retrace from the start follows the loop-erased path.
+class SpanningTree {
+public:
+	SpanningTree();
+
+	//sites per axis; the root is the corner site (0, 0, 0)
+	void SetBox(int nx, int ny, int nz);
+	void Sample();
+
+	int Index(int x, int y, int z) const
+	{
+		return ((((z >> 2) * bricks[1] + (y >> 2)) * bricks[0] + (x >> 2)) << 6) | ((z & 3) << 4) | ((y & 3) << 2) | (x & 3);
+	}
+	int Sites() const { return size[0] * size[1] * size[2]; }
+
+	//centred on the origin like the visual walk
+	glm::vec3 Point(int x, int y, int z) const;
+
+	//per site: the number of tree edges at it
+	void Degrees(std::vector<unsigned char>& degree) const;
+	//every edge as a start and end point, for drawing
+	void Edges(std::vector<glm::vec3>& lines) const;
+
+	//binary file the window loads: "RWT1", sizes, then the parent
+	//direction of every site with x running fastest
+	bool Write(const std::string& path) const;
+	bool Read(const std::string& path);
+
+	int size[3];
+	std::vector<unsigned char> parent;
+	//lengths of the branches the last Sample added, in the order added
+	std::vector<int> branches;
+	Rng rng;
+
+private:
+	bool InTree(int site) const { return (inTree[site >> 6] >> (site & 63)) & 1; }
+
+	int bricks[3];
+	std::vector<uint64_t> inTree;
+};
+
+// Averages over trials trees of an n x n x n box: branch length, and the
+// fractions of leaves and of sites where the tree branches (degree 3 or more).
+void TreeTrials(SpanningTree& tree, int n, int trials, float& branch, float& leaves, float& branch_points);
+
+#endif
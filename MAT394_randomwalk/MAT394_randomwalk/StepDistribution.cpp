@@ -0,0 +1,147 @@
+/* Start Header -------------------------------------------------------
+File Name: StepDistribution.cpp
+Purpose: Weighted lattice steps drawn from alias tables
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+
+#include "StepDistribution.hpp"
+
+void AliasTable::Build(const double weights[6])
+{
+	double total = 0.0;
+	for (int d = 0; d < 6; ++d)
+		total += weights[d];
+
+	//scaled so the average column is full
+	double scaled[6];
+	int small[6], large[6];
+	int smalls = 0, larges = 0;
+	for (int d = 0; d < 6; ++d)
+	{
+		scaled[d] = weights[d] * 6.0 / total;
+		if (scaled[d] < 1.0)
+			small[smalls++] = d;
+		else
+			large[larges++] = d;
+	}
+
+	//a small column is topped up from a large one, which may become small
+	while (smalls && larges)
+	{
+		int s = small[--smalls];
+		int l = large[--larges];
+		threshold[s] = (uint32_t)ldexp(scaled[s], 32);
+		alias[s] = (unsigned char)l;
+		scaled[l] -= 1.0 - scaled[s];
+		if (scaled[l] < 1.0)
+			small[smalls++] = l;
+		else
+			large[larges++] = l;
+	}
+
+	//what is left is full up to rounding; never take its alias
+	while (larges)
+	{
+		int l = large[--larges];
+		threshold[l] = 0xFFFFFFFFu;
+		alias[l] = (unsigned char)l;
+	}
+	while (smalls)
+	{
+		int s = small[--smalls];
+		threshold[s] = 0xFFFFFFFFu;
+		alias[s] = (unsigned char)s;
+	}
+}
+
+StepDistribution::StepDistribution()
+{
+	for (int d = 0; d < 6; ++d)
+		weights[d] = 1.0;
+	pull = 0.0;
+	memory = false;
+	persistence = 1.0 / 6.0;
+	reversal = 1.0 / 6.0;
+	Build();
+}
+
+void StepDistribution::Set(const double direction_weights[6], double origin_pull)
+{
+	for (int d = 0; d < 6; ++d)
+		weights[d] = direction_weights[d];
+	pull = origin_pull;
+	Build();
+}
+
+void StepDistribution::SetMemory(bool correlated, double repeat, double back)
+{
+	memory = correlated;
+	persistence = repeat;
+	reversal = back;
+	Build();
+}
+
+void StepDistribution::Weights(int region, int last, double m[6]) const
+{
+	//sign of the position along x, y and z, -1, 0 or 1
+	int sign[3] = { region / 9 - 1, region / 3 % 3 - 1, region % 3 - 1 };
+	for (int d = 0; d < 6; ++d)
+		m[d] = weights[d];
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		//X_UP + axis heads back from below, X_DOWN + axis from above
+		if (sign[axis] < 0)
+			m[axis] *= 1.0 + pull;
+		else if (sign[axis] > 0)
+			m[3 + axis] *= 1.0 + pull;
+	}
+
+	double turn = (1.0 - persistence - reversal) / 4.0;
+	for (int d = 0; d < 6 && memory && last != STEP_FIRST; ++d)
+		m[d] *= d == last ? persistence : d == (last + 3) % 6 ? reversal : turn;
+}
+
+void StepDistribution::Build()
+{
+	for (int region = 0; region < STEP_REGIONS; ++region)
+	{
+		for (int last = 0; last < STEP_HISTORIES; ++last)
+		{
+			double m[6];
+			Weights(region, last, m);
+			tables[region][last].Build(m);
+		}
+	}
+}
+
+bool StepDistribution::Blocked(const glm::vec3& at, int last, const glm::vec3& low, const glm::vec3& high) const
+{
+	double m[6];
+	Weights(Region(at), last, m);
+	for (int d = 0; d < 6; ++d)
+	{
+		//X_UP + axis and X_DOWN + axis
+		glm::vec3 to = at;
+		to[d % 3] += d < 3 ? 1.f : -1.f;
+		bool inside = to.x >= low.x && to.y >= low.y && to.z >= low.z && to.x <= high.x && to.y <= high.y && to.z <= high.z;
+		if (m[d] > 0.0 && inside)
+			return false;
+	}
+	return true;
+}
+
+bool StepDistribution::IsUniform() const
+{
+	for (int d = 1; d < 6; ++d)
+	{
+		if (weights[d] != weights[0])
+			return false;
+	}
+	return pull == 0.0 && !memory;
+}
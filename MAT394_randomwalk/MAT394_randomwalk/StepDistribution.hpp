@@ -0,0 +1,95 @@
+/* Start Header -------------------------------------------------------
+File Name: StepDistribution.hpp
+Purpose: Weighted lattice steps drawn from alias tables
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef STEPDISTRIBUTION_HPP
+#define STEPDISTRIBUTION_HPP
+
+#include <stdint.h>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+
+//below, on or above zero along each axis
+#define STEP_REGIONS 27
+
+//the last step in the order of Direction, or none before the first one
+#define STEP_HISTORIES 7
+#define STEP_FIRST 6
+
+// Walker's alias method over the six directions, built by Vose's method.
+// A draw is one 64-bit number: the high half picks a column, the low half
+// decides between the column and its alias.
+struct AliasTable {
+	uint32_t threshold[6];
+	unsigned char alias[6];
+
+	void Build(const double weights[6]);
+
+	int Sample(Rng& rng) const
+	{
+		uint64_t r = rng.Next();
+		int column = (int)(((r >> 32) * 6) >> 32);
+		return (uint32_t)r < threshold[column] ? column : alias[column];
+	}
+};
+
+// Weights of the six directions, in the order of Direction, and a pull
+// toward the origin: along every axis, the step back toward 0 has its
+// weight multiplied by 1 + pull. The pull makes the weights depend on the
+// octant, so there is one table for each of the 27 sign patterns of the
+// position and a step costs one lookup more than a uniform one.
+// With memory the walk is correlated: it repeats its last step with
+// probability persistence, reverses it with probability reversal and turns
+// otherwise, each of the four turns alike, before the weights apply.
+// reversal 0 is the non-backtracking walk, a small one a walk that mostly
+// avoids the site it just left. That is one table per last step as well,
+// so the walker carries its last direction and a step stays one lookup.
+class StepDistribution {
+public:
+	StepDistribution();
+
+	void Set(const double direction_weights[6], double origin_pull);
+	void SetMemory(bool correlated, double repeat, double back);
+	bool IsUniform() const;
+
+	static int Region(const glm::vec3& at)
+	{
+		int x = (at.x > 0.f) - (at.x < 0.f) + 1;
+		int y = (at.y > 0.f) - (at.y < 0.f) + 1;
+		int z = (at.z > 0.f) - (at.z < 0.f) + 1;
+		return (x * 3 + y) * 3 + z;
+	}
+
+	int Sample(Rng& rng, const glm::vec3& at, int last) const
+	{
+		return tables[Region(at)][last].Sample(rng);
+	}
+
+	// Whether every step with weight after last leaves the box [low, high]
+	// from at. A walk that redraws its rejected steps then never gets out,
+	// e.g. persistence 1 against a wall; it goes on as if it had no last
+	// step, which Sample with STEP_FIRST draws.
+	bool Blocked(const glm::vec3& at, int last, const glm::vec3& low, const glm::vec3& high) const;
+
+	double weights[6];
+	double pull;
+	bool memory;
+	double persistence;
+	double reversal;
+
+private:
+	void Build();
+	void Weights(int region, int last, double m[6]) const;
+
+	AliasTable tables[STEP_REGIONS][STEP_HISTORIES];
+};
+
+#endif
@@ -0,0 +1,78 @@
+/* Start Header -------------------------------------------------------
+File Name: ThreadPool.cpp
+Purpose: Fixed set of worker threads shared by the batch experiments
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <string>
+
+#include "ThreadPool.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+ThreadPool::ThreadPool(int threads)
+{
+	running = 0;
+	quit = false;
+	if (threads <= 0)
+		threads = (int)std::thread::hardware_concurrency();
+	if (threads <= 0)
+		threads = 1;
+	for (int i = 0; i < threads; ++i)
+		workers.push_back(std::thread(&ThreadPool::Worker, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	wake.notify_all();
+	for (size_t i = 0; i < workers.size(); ++i)
+		workers[i].join();
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(task);
+	}
+	wake.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+void ThreadPool::Worker(int index)
+{
+	std::string name = "worker " + std::to_string(index);
+	RegisterStatsThread(name.c_str());
+	TRACE_THREAD(name.c_str());
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		wake.wait(lock, [this] { return quit || !tasks.empty(); });
+		if (tasks.empty())
+			return;
+
+		std::function<void()> task = tasks.front();
+		tasks.pop_front();
+		++running;
+		lock.unlock();
+		task();
+		lock.lock();
+		--running;
+		if (tasks.empty() && running == 0)
+			idle.notify_all();
+	}
+}
@@ -0,0 +1,45 @@
+/* Start Header -------------------------------------------------------
+File Name: ThreadPool.hpp
+Purpose: Fixed set of worker threads shared by the batch experiments
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Tasks may submit more tasks; Wait returns once the queue is empty and no
+// task is running, so follow-up work submitted by a task is waited for too.
+class ThreadPool {
+public:
+	explicit ThreadPool(int threads = 0);
+	~ThreadPool();
+
+	void Submit(std::function<void()> task);
+	void Wait();
+	int Size() const { return (int)workers.size(); }
+
+private:
+	void Worker(int index);
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable idle;
+	int running;
+	bool quit;
+};
+
+#endif
@@ -0,0 +1,190 @@
+/* Start Header -------------------------------------------------------
+File Name: Trace.cpp
+Purpose: Per-thread trace rings and Chrome trace export
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#define _CRT_SECURE_NO_DEPRECATE
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include "Trace.hpp"
+
+// Only the owning thread writes its ring; head counts every event ever
+// written so the exporter knows which ones have been overwritten. A ring
+// outlives its thread and goes to the next thread of the same name.
+struct TraceRing {
+	TraceEvent events[TRACE_CAPACITY];
+	std::atomic<long long> head;
+	std::atomic<bool> in_use;
+	char name[32];
+};
+
+static std::atomic<TraceRing*> rings[MAX_TRACE_THREADS];
+static std::atomic<int> ringCount(0);
+static std::mutex ringMutex;
+static thread_local TraceRing* localRing = NULL;
+//set once a thread found no ring, or gave its ring back, so its zones stop
+//asking for one
+static thread_local bool untraced = false;
+
+// Gives the ring of a thread back when the thread exits.
+struct TraceRingRelease {
+	~TraceRingRelease()
+	{
+		std::lock_guard<std::mutex> lock(ringMutex);
+		if (localRing)
+			localRing->in_use.store(false, std::memory_order_relaxed);
+		localRing = NULL;
+		untraced = true;
+	}
+};
+
+long long TraceNow()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TraceRing* TraceThread(const char* name)
+{
+	if (localRing || untraced)
+		return localRing;
+	thread_local TraceRingRelease release;
+	(void)release;
+
+	//a free ring of the same name keeps the events of the threads before;
+	//past the last ring, any free one starts over under the new name
+	std::lock_guard<std::mutex> lock(ringMutex);
+	int count = ringCount.load();
+	TraceRing* ring = NULL;
+	for (int i = 0; i < count && !ring; ++i)
+	{
+		TraceRing* other = rings[i].load(std::memory_order_relaxed);
+		if (!other->in_use.load(std::memory_order_relaxed) && strncmp(other->name, name, sizeof(other->name) - 1) == 0)
+			ring = other;
+	}
+	if (!ring && count < MAX_TRACE_THREADS)
+	{
+		ring = new TraceRing;
+		ring->head.store(0, std::memory_order_relaxed);
+		memset(ring->name, 0, sizeof(ring->name));
+		strncpy(ring->name, name, sizeof(ring->name) - 1);
+		rings[count].store(ring, std::memory_order_release);
+		ringCount.store(count + 1);
+	}
+	for (int i = 0; i < count && !ring; ++i)
+	{
+		TraceRing* other = rings[i].load(std::memory_order_relaxed);
+		if (!other->in_use.load(std::memory_order_relaxed))
+		{
+			ring = other;
+			ring->head.store(0, std::memory_order_relaxed);
+			memset(ring->name, 0, sizeof(ring->name));
+			strncpy(ring->name, name, sizeof(ring->name) - 1);
+		}
+	}
+
+	//every ring belongs to a running thread, this one is not traced
+	if (!ring)
+	{
+		untraced = true;
+		return NULL;
+	}
+	ring->in_use.store(true, std::memory_order_relaxed);
+	localRing = ring;
+	return ring;
+}
+
+void TraceRecord(const char* name, long long start, long long end)
+{
+	TraceRing* ring = localRing ? localRing : TraceThread("thread");
+	if (!ring)
+		return;
+
+	long long head = ring->head.load(std::memory_order_relaxed);
+	TraceEvent& e = ring->events[head & (TRACE_CAPACITY - 1)];
+	e.name = name;
+	e.start = start;
+	e.duration = end - start;
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+// Rings keep being written while this runs, so the oldest events of a busy
+// thread can be overwritten under the exporter; those few are skipped.
+bool WriteChromeTrace(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	//rings can change hands, not while their names are read
+	std::lock_guard<std::mutex> lock(ringMutex);
+	int count = ringCount.load();
+	long long origin = -1;
+	std::vector<std::vector<TraceEvent>> copies(count);
+	for (int t = 0; t < count; ++t)
+	{
+		TraceRing* ring = rings[t].load(std::memory_order_acquire);
+		if (!ring)
+			continue;
+
+		long long head = ring->head.load(std::memory_order_acquire);
+		long long first = std::max(0LL, head - TRACE_CAPACITY);
+		for (long long i = first; i < head; ++i)
+			copies[t].push_back(ring->events[i & (TRACE_CAPACITY - 1)]);
+
+		//whatever was overwritten while copying is dropped
+		long long after = ring->head.load(std::memory_order_acquire);
+		long long overwritten = std::min((long long)copies[t].size(), std::max(0LL, after - TRACE_CAPACITY - first));
+		copies[t].erase(copies[t].begin(), copies[t].begin() + overwritten);
+
+		for (size_t i = 0; i < copies[t].size(); ++i)
+			if (origin < 0 || copies[t][i].start < origin)
+				origin = copies[t][i].start;
+	}
+
+	fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+	bool first = true;
+	for (int t = 0; t < count; ++t)
+	{
+		TraceRing* ring = rings[t].load(std::memory_order_acquire);
+		if (!ring)
+			continue;
+
+		fprintf(file, "%s{\"ph\": \"M\", \"pid\": 1, \"tid\": %i, \"name\": \"thread_name\", \"args\": {\"name\": \"%s\"}}",
+			first ? "" : ",\n", t, ring->name);
+		first = false;
+
+		for (size_t i = 0; i < copies[t].size(); ++i)
+		{
+			const TraceEvent& e = copies[t][i];
+			fprintf(file, ",\n{\"ph\": \"X\", \"pid\": 1, \"tid\": %i, \"name\": \"%s\", \"ts\": %.3f, \"dur\": %.3f}",
+				t, e.name, (e.start - origin) * 1e-3, e.duration * 1e-3);
+		}
+	}
+	fprintf(file, "\n]}\n");
+	fclose(file);
+	return true;
+}
+
+// Like ResetStats, meant for the moments no experiment is running.
+void ClearTrace()
+{
+	int count = ringCount.load();
+	for (int t = 0; t < count; ++t)
+	{
+		TraceRing* ring = rings[t].load(std::memory_order_acquire);
+		if (ring)
+			ring->head.store(0, std::memory_order_relaxed);
+	}
+}
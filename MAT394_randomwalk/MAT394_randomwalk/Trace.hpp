@@ -0,0 +1,62 @@
+/* Start Header -------------------------------------------------------
+File Name: Trace.hpp
+Purpose: Scoped trace zones exported as Chrome trace JSON.
+		 Define RW_TRACE to record experiment and frame phases and
+		 RW_TRACE_FINE to also record every trial, step and loop search.
+		 Without RW_TRACE the zones compile to nothing.
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#define TRACE_CAPACITY (1 << 16)
+#define MAX_TRACE_THREADS 64
+
+struct TraceEvent {
+	const char* name;
+	long long start;
+	long long duration;
+};
+
+struct TraceRing;
+
+TraceRing* TraceThread(const char* name);
+void TraceRecord(const char* name, long long start, long long end);
+long long TraceNow();
+
+bool WriteChromeTrace(const char* path);
+void ClearTrace();
+
+class TraceZone {
+public:
+	TraceZone(const char* _name) : name(_name), start(TraceNow()) {}
+	~TraceZone() { TraceRecord(name, start, TraceNow()); }
+private:
+	const char* name;
+	long long start;
+};
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+
+#ifdef RW_TRACE
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_THREAD(name) TraceThread(name)
+#else
+#define TRACE_ZONE(name)
+#define TRACE_THREAD(name)
+#endif
+
+#if defined(RW_TRACE) && defined(RW_TRACE_FINE)
+#define TRACE_ZONE_FINE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#define TRACE_ZONE_FINE(name)
+#endif
+
+#endif
@@ -0,0 +1,282 @@
+/* Start Header -------------------------------------------------------
+File Name: TrajectoryAnalysis.cpp
+Purpose: Time-averaged MSD and step autocorrelation of one long walk
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include <math.h>
+#include <complex>
+#include <functional>
+#include <mutex>
+#include <algorithm>
+
+#include "TrajectoryAnalysis.hpp"
+#include "ThreadPool.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+#define PI 3.14159265358979323846
+
+typedef std::complex<double> Complex;
+
+//positions along one axis, one per point of the walk
+typedef std::function<void(int axis, std::vector<double>& x)> AxisFill;
+
+static const int StepX[6] = { 1, 0, 0, -1, 0, 0 };
+static const int StepY[6] = { 0, 1, 0, 0, -1, 0 };
+static const int StepZ[6] = { 0, 0, 1, 0, 0, -1 };
+
+void WalkDirections(RandomWalk& rw, int steps, std::vector<unsigned char>& directions)
+{
+	TRACE_ZONE("WalkDirections");
+	directions.resize(steps);
+	glm::ivec3 p(rw.points.back());
+	glm::ivec3 low((int)ceil(rw.limit_min.x), (int)ceil(rw.limit_min.y), (int)ceil(rw.limit_min.z));
+	glm::ivec3 high((int)floor(rw.limit_max.x), (int)floor(rw.limit_max.y), (int)floor(rw.limit_max.z));
+
+	long long rejections = 0;
+	int last = rw.last_direction;
+	for (int i = 0; i < steps; ++i)
+	{
+		for (;;)
+		{
+			int d = rw.biased ? rw.bias.Sample(rw.rng, glm::vec3(p), last) : rw.rng.Below(6);
+			glm::ivec3 q(p.x + StepX[d], p.y + StepY[d], p.z + StepZ[d]);
+			if (rw.limit && (q.x < low.x || q.y < low.y || q.z < low.z || q.x > high.x || q.y > high.y || q.z > high.z))
+			{
+				++rejections;
+				if (rw.biased && rw.bias.memory && last != STEP_FIRST && rw.bias.Blocked(glm::vec3(p), last, rw.limit_min, rw.limit_max))
+					last = STEP_FIRST;
+				continue;
+			}
+			p = q;
+			last = d;
+			directions[i] = (unsigned char)d;
+			break;
+		}
+	}
+	StatAdd(STAT_STEPS, steps);
+	StatAdd(STAT_REJECTIONS, rejections);
+}
+
+// Iterative radix-2; twiddle holds exp(-2 pi i k / n) for k < n / 2.
+static void Fft(std::vector<Complex>& a, const std::vector<Complex>& twiddle)
+{
+	size_t n = a.size();
+	for (size_t i = 1, j = 0; i < n; ++i)
+	{
+		size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(a[i], a[j]);
+	}
+
+	for (size_t len = 2; len <= n; len <<= 1)
+	{
+		size_t half = len >> 1;
+		size_t stride = n / len;
+		for (size_t i = 0; i < n; i += len)
+		{
+			for (size_t k = 0; k < half; ++k)
+			{
+				//written out, the library product checks for inf and nan
+				const Complex& b = a[i + k + half];
+				const Complex& w = twiddle[k * stride];
+				Complex u = a[i + k];
+				Complex v(b.real() * w.real() - b.imag() * w.imag(), b.real() * w.imag() + b.imag() * w.real());
+				a[i + k] = u + v;
+				a[i + k + half] = u - v;
+			}
+		}
+	}
+}
+
+// Spectrum X[0..L/2] of the real x[0..L-1] from one complex FFT of half the
+// length: the even samples go in the real part and the odd ones in the
+// imaginary part, and the two halves are pulled apart afterwards. Leaves
+// X[k] in z[k] for k < L/2 and returns the real X[L/2].
+static double RealFft(const std::vector<double>& x, std::vector<Complex>& z, std::vector<Complex>& twiddle)
+{
+	size_t h = x.size() / 2;
+	z.resize(h);
+	for (size_t k = 0; k < h; ++k)
+		z[k] = Complex(x[2 * k], x[2 * k + 1]);
+	if (twiddle.size() != h / 2)
+	{
+		twiddle.resize(h / 2);
+		for (size_t k = 0; k < h / 2; ++k)
+			twiddle[k] = std::polar(1.0, -2.0 * PI * k / h);
+	}
+	Fft(z, twiddle);
+
+	double last = z[0].real() - z[0].imag();
+	z[0] = Complex(z[0].real() + z[0].imag(), 0.0);
+	for (size_t k = 1; k <= h / 2; ++k)
+	{
+		Complex a = z[k];
+		Complex b = z[h - k];
+		Complex even = (a + std::conj(b)) * 0.5;
+		Complex odd = (a - std::conj(b)) * Complex(0.0, -0.5);
+		Complex w = std::polar(1.0, -PI * k / h);
+		z[k] = even + w * odd;
+		z[h - k] = std::conj(even - w * odd);
+	}
+	return last;
+}
+
+// sum over i of x_i x_{i+m} for every m < n, left in x[0..n-1]. The power
+// spectrum is real and even, so its inverse transform is the forward one
+// over L, and the same real FFT does both.
+static void Autocorrelation(std::vector<double>& x, size_t n, std::vector<Complex>& z, std::vector<Complex>& twiddle)
+{
+	size_t length = 2;
+	while (length < 2 * n)
+		length *= 2;
+	x.resize(length);
+	std::fill(x.begin() + n, x.end(), 0.0);
+
+	size_t h = length / 2;
+	double last = RealFft(x, z, twiddle);
+	x[0] = std::norm(z[0]);
+	x[h] = last * last;
+	for (size_t k = 1; k < h; ++k)
+		x[k] = x[length - k] = std::norm(z[k]);
+
+	RealFft(x, z, twiddle);
+	for (size_t m = 0; m < n; ++m)
+		x[m] = z[m].real() / length;
+	x.resize(n);
+}
+
+// MSD along one axis as S1 - 2 S2: S2 is the autocorrelation of the
+// positions and S1 the squares summed over both ends of the lag, which one
+// running sum gives for every lag.
+static void AnalyzeAxis(int axis, size_t points, const AxisFill& fill, TrajectoryStats& stats, std::mutex& mutex)
+{
+	TRACE_ZONE("AnalyzeAxis");
+	std::vector<double> x;
+	std::vector<Complex> z, twiddle;
+
+	//centred, so the sums stay small next to the lags that matter
+	fill(axis, x);
+	double mean = 0.0;
+	for (size_t i = 0; i < points; ++i)
+		mean += x[i];
+	mean /= points;
+	double q = 0.0;
+	for (size_t i = 0; i < points; ++i)
+	{
+		x[i] -= mean;
+		q += 2.0 * x[i] * x[i];
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t m = 0; m < points; ++m)
+		{
+			if (m)
+				q -= x[m - 1] * x[m - 1] + x[points - m] * x[points - m];
+			stats.msd[m] += q / (points - m);
+		}
+	}
+	Autocorrelation(x, points, z, twiddle);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t m = 0; m < points; ++m)
+			stats.msd[m] -= 2.0 * x[m] / (points - m);
+	}
+
+	//the steps are the differences of the positions
+	size_t steps = points - 1;
+	fill(axis, x);
+	for (size_t i = 0; i < steps; ++i)
+		x[i] = x[i + 1] - x[i];
+	Autocorrelation(x, steps, z, twiddle);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t m = 0; m < steps; ++m)
+			stats.acf[m] += x[m] / (steps - m);
+	}
+}
+
+static void Analyze(size_t points, const AxisFill& fill, ThreadPool* pool, TrajectoryStats& stats)
+{
+	TRACE_ZONE("AnalyzeTrajectory");
+	stats.msd.assign(points, 0.0);
+	stats.acf.assign(points > 1 ? points - 1 : 0, 0.0);
+	if (points < 2)
+		return;
+
+	//a long walk runs one axis at a time, so only one holds its buffers
+	bool parallel = pool && points <= TRAJECTORY_PARALLEL_POINTS;
+	std::mutex mutex;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (parallel)
+			pool->Submit([axis, points, &fill, &stats, &mutex]() { AnalyzeAxis(axis, points, fill, stats, mutex); });
+		else
+			AnalyzeAxis(axis, points, fill, stats, mutex);
+	}
+	if (parallel)
+		pool->Wait();
+}
+
+void AnalyzeTrajectory(const std::vector<unsigned char>& directions, ThreadPool* pool, TrajectoryStats& stats)
+{
+	//rebuilt from the directions every time an axis needs them
+	AxisFill fill = [&directions](int axis, std::vector<double>& x)
+	{
+		x.resize(directions.size() + 1);
+		int p = 0;
+		x[0] = 0.0;
+		for (size_t i = 0; i < directions.size(); ++i)
+		{
+			int d = directions[i];
+			p += (d == axis) - (d == axis + 3);
+			x[i + 1] = p;
+		}
+	};
+	Analyze(directions.size() + 1, fill, pool, stats);
+}
+
+void AnalyzeTrajectory(const std::vector<glm::vec3>& points, ThreadPool* pool, TrajectoryStats& stats)
+{
+	AxisFill fill = [&points](int axis, std::vector<double>& x)
+	{
+		x.resize(points.size() - 1);
+		for (size_t i = 1; i < points.size(); ++i)
+			x[i - 1] = points[i][axis];
+	};
+	Analyze(points.size() > 1 ? points.size() - 1 : 0, fill, pool, stats);
+}
+
+bool WriteTrajectoryStats(const std::string& path, const TrajectoryStats& stats, const RunMetadata& meta)
+{
+	std::vector<ResultColumn> columns;
+	columns.push_back({ "lag", COLUMN_INT64 });
+	columns.push_back({ "msd", COLUMN_FLOAT64 });
+	columns.push_back({ "step_autocorrelation", COLUMN_FLOAT64 });
+
+	ResultSink* sink = CreateResultSink(path);
+	if (!sink->Open(path, columns, meta))
+	{
+		delete sink;
+		return false;
+	}
+
+	size_t lag = 0;
+	while (lag < stats.msd.size())
+	{
+		double row[3] = { (double)lag, stats.msd[lag], lag < stats.acf.size() ? stats.acf[lag] : NAN };
+		sink->Append(row);
+		lag = std::max(lag + 1, (size_t)(lag * 1.1220184543));
+	}
+	sink->Close();
+	delete sink;
+	return true;
+}
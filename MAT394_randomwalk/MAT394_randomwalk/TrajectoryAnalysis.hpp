@@ -0,0 +1,52 @@
+/* Start Header -------------------------------------------------------
+File Name: TrajectoryAnalysis.hpp
+Purpose: Time-averaged MSD and step autocorrelation of one long walk
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef TRAJECTORYANALYSIS_HPP
+#define TRAJECTORYANALYSIS_HPP
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "RandomWalk.hpp"
+#include "ResultSink.hpp"
+
+#define TRAJECTORY_PARALLEL_POINTS (1 << 22)
+
+class ThreadPool;
+
+// Over every lag m of one walk r_0..r_n with steps s_i = r_{i+1} - r_i:
+//	msd[m] = 1/(n+1-m) sum_i |r_{i+m} - r_i|^2
+//	acf[m] = 1/(n-m) sum_i s_i . s_{i+m}
+// Both come from autocorrelations done with a real FFT, O(n log n) instead
+// of O(n^2). An axis holds about 20 L bytes while it runs, L the power of
+// two at least 2n, so 40 to 80 bytes a step, and the results another 16.
+// Up to TRAJECTORY_PARALLEL_POINTS the axes run on their own pool threads,
+// past it one after another: 10^8 steps need about 7 GB.
+struct TrajectoryStats {
+	std::vector<double> msd;
+	std::vector<double> acf;
+};
+
+// Compact path: one Direction per step, a twelfth of the points it stands
+// for. Walks like RandomWalk::Walk, box included, with rw's generator.
+void WalkDirections(RandomWalk& rw, int steps, std::vector<unsigned char>& directions);
+
+// pool may be NULL to run on the calling thread. The points version skips
+// points[0], the copy of the start RandomWalk keeps.
+void AnalyzeTrajectory(const std::vector<unsigned char>& directions, ThreadPool* pool, TrajectoryStats& stats);
+void AnalyzeTrajectory(const std::vector<glm::vec3>& points, ThreadPool* pool, TrajectoryStats& stats);
+
+// lag, msd, step_autocorrelation at every lag up to 10, then 20 lags per
+// decade.
+bool WriteTrajectoryStats(const std::string& path, const TrajectoryStats& stats, const RunMetadata& meta);
+
+#endif
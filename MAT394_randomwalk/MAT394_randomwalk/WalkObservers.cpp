@@ -0,0 +1,50 @@
+/* Start Header -------------------------------------------------------
+File Name: WalkObservers.cpp
+Purpose: Online statistics of a walk's shape, plugged into the step loop
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include "WalkObservers.hpp"
+
+void GyrationObserver::Tensor(double t[6]) const
+{
+	double mean[3];
+	for (int a = 0; a < 3; ++a)
+		mean[a] = (double)sum[a] / n;
+	t[0] = (double)sum2[0] / n - mean[0] * mean[0];
+	t[1] = (double)sum2[1] / n - mean[1] * mean[1];
+	t[2] = (double)sum2[2] / n - mean[2] * mean[2];
+	t[3] = (double)sum2[3] / n - mean[0] * mean[1];
+	t[4] = (double)sum2[4] / n - mean[0] * mean[2];
+	t[5] = (double)sum2[5] / n - mean[1] * mean[2];
+}
+
+// With the invariants of the tensor, I1 = trace and I2 = the sum of its
+// principal 2x2 minors, the asphericity
+//	sum over pairs (l_i - l_j)^2 / (2 (l_1 + l_2 + l_3)^2) = 1 - 3 I2 / I1^2
+// needs no eigenvalues.
+void GyrationObserver::End()
+{
+	double t[6];
+	Tensor(t);
+	double i1 = t[0] + t[1] + t[2];
+	double i2 = t[0] * t[1] + t[0] * t[2] + t[1] * t[2] - t[3] * t[3] - t[4] * t[4] - t[5] * t[5];
+	total_gyration2 += i1;
+	if (i1 > 0.0)
+		total_asphericity += 1.0 - 3.0 * i2 / (i1 * i1);
+}
+
+void ShapeTrials(RandomWalk& walker, int steps, int trials, float& gyration2, float& asphericity, float& span, float& max_displacement)
+{
+	Observers<GyrationObserver, SpanObserver, DisplacementObserver> shape;
+	ObservedTrials(walker, steps, trials, shape);
+
+	gyration2 = (float)(shape.total_gyration2 / trials);
+	asphericity = (float)(shape.total_asphericity / trials);
+	span = (float)((shape.total_span[0] + shape.total_span[1] + shape.total_span[2]) / (3.0 * trials));
+	max_displacement = (float)(shape.total_max / trials);
+}
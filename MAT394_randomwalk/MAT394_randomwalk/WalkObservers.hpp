@@ -0,0 +1,196 @@
+/* Start Header -------------------------------------------------------
+File Name: WalkObservers.hpp
+Purpose: Online statistics of a walk's shape, plugged into the step loop
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef WALKOBSERVERS_HPP
+#define WALKOBSERVERS_HPP
+
+#include <math.h>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+#include "RandomWalk.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+// An observer sees every site of a walk without the path being kept:
+//	Begin(start)	a new walk
+//	Step(site)		every site after the start
+//	End()			the walk is over, add it to the totals
+// and keeps its totals over the walks it saw. Observers<...> chains several
+// into one; the trial loop is a template on it, so every Step call is
+// inlined and an observer that is not listed costs nothing.
+
+// Gyration tensor from running sums of the sites relative to the start.
+// The sums are exact integers, so a long walk loses nothing to rounding.
+struct GyrationObserver {
+	long long n;
+	long long sum[3];
+	//xx, yy, zz, xy, xz, yz
+	long long sum2[6];
+	glm::ivec3 start;
+
+	double total_gyration2;
+	double total_asphericity;
+
+	GyrationObserver() : total_gyration2(0.0), total_asphericity(0.0) {}
+
+	void Begin(const glm::ivec3& site)
+	{
+		start = site;
+		n = 1;
+		for (int a = 0; a < 3; ++a)
+			sum[a] = 0;
+		for (int a = 0; a < 6; ++a)
+			sum2[a] = 0;
+	}
+	void Step(const glm::ivec3& site)
+	{
+		glm::ivec3 d = site - start;
+		++n;
+		sum[0] += d.x;
+		sum[1] += d.y;
+		sum[2] += d.z;
+		sum2[0] += (long long)d.x * d.x;
+		sum2[1] += (long long)d.y * d.y;
+		sum2[2] += (long long)d.z * d.z;
+		sum2[3] += (long long)d.x * d.y;
+		sum2[4] += (long long)d.x * d.z;
+		sum2[5] += (long long)d.y * d.z;
+	}
+	void End();
+
+	//of the walk since Begin
+	void Tensor(double t[6]) const;
+};
+
+// Smallest box around the walk, per axis.
+struct SpanObserver {
+	glm::ivec3 low;
+	glm::ivec3 high;
+
+	double total_span[3];
+
+	SpanObserver() { total_span[0] = total_span[1] = total_span[2] = 0.0; }
+
+	void Begin(const glm::ivec3& site)
+	{
+		low = high = site;
+	}
+	void Step(const glm::ivec3& site)
+	{
+		low = glm::min(low, site);
+		high = glm::max(high, site);
+	}
+	void End()
+	{
+		for (int a = 0; a < 3; ++a)
+			total_span[a] += high[a] - low[a];
+	}
+};
+
+// Farthest the walk got from its start.
+struct DisplacementObserver {
+	glm::ivec3 start;
+	long long max2;
+
+	double total_max;
+
+	DisplacementObserver() : total_max(0.0) {}
+
+	void Begin(const glm::ivec3& site)
+	{
+		start = site;
+		max2 = 0;
+	}
+	void Step(const glm::ivec3& site)
+	{
+		glm::ivec3 d = site - start;
+		max2 = std::max(max2, (long long)d.x * d.x + (long long)d.y * d.y + (long long)d.z * d.z);
+	}
+	void End()
+	{
+		total_max += sqrt((double)max2);
+	}
+};
+
+template <class... List>
+struct Observers : List... {
+	void Begin(const glm::ivec3& site)
+	{
+		int expand[] = { 0, (List::Begin(site), 0)... };
+		(void)expand;
+	}
+	void Step(const glm::ivec3& site)
+	{
+		int expand[] = { 0, (List::Step(site), 0)... };
+		(void)expand;
+	}
+	void End()
+	{
+		int expand[] = { 0, (List::End(), 0)... };
+		(void)expand;
+	}
+};
+
+// trials lattice walks of steps steps from the origin with the box and
+// bias of walker, with observer watching. The position is stepped here the
+// way ReturnTimeTrials does, and walker.points is left alone.
+template <class Observer>
+void ObservedTrials(RandomWalk& walker, int steps, int trials, Observer& observer)
+{
+	TRACE_ZONE("ObservedTrials");
+	StatBusy busy;
+	static const glm::ivec3 moves[6] = {
+		glm::ivec3(1, 0, 0), glm::ivec3(0, 1, 0), glm::ivec3(0, 0, 1),
+		glm::ivec3(-1, 0, 0), glm::ivec3(0, -1, 0), glm::ivec3(0, 0, -1)
+	};
+	glm::ivec3 low((int)ceil(walker.limit_min.x), (int)ceil(walker.limit_min.y), (int)ceil(walker.limit_min.z));
+	glm::ivec3 high((int)floor(walker.limit_max.x), (int)floor(walker.limit_max.y), (int)floor(walker.limit_max.z));
+
+	long long rejections = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		TRACE_ZONE_FINE("Trial");
+		glm::ivec3 p(0, 0, 0);
+		int last = STEP_FIRST;
+		observer.Begin(p);
+		for (int j = 0; j < steps; ++j)
+		{
+			for (;;)
+			{
+				int d = walker.biased ? walker.bias.Sample(walker.rng, glm::vec3(p), last) : walker.rng.Below(6);
+				glm::ivec3 q = p + moves[d];
+				if (walker.limit && (q.x < low.x || q.y < low.y || q.z < low.z || q.x > high.x || q.y > high.y || q.z > high.z))
+				{
+					++rejections;
+					if (walker.biased && walker.bias.memory && last != STEP_FIRST && walker.bias.Blocked(glm::vec3(p), last, walker.limit_min, walker.limit_max))
+						last = STEP_FIRST;
+					continue;
+				}
+				p = q;
+				last = d;
+				break;
+			}
+			observer.Step(p);
+		}
+		observer.End();
+		StatAdd(STAT_TRIALS);
+	}
+	StatAdd(STAT_STEPS, (long long)steps * trials);
+	StatAdd(STAT_REJECTIONS, rejections);
+}
+
+// Averages over trials walks: radius of gyration^2, asphericity (0 for a
+// sphere, 1 for a rod), span averaged over the axes, and the largest
+// distance from the start.
+void ShapeTrials(RandomWalk& walker, int steps, int trials, float& gyration2, float& asphericity, float& span, float& max_displacement);
+
+#endif
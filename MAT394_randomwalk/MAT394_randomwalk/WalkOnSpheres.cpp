@@ -0,0 +1,65 @@
+/* Start Header -------------------------------------------------------
+File Name: WalkOnSpheres.cpp
+Purpose: Walk-on-spheres estimates of exit distributions in a box
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+
+#include "WalkOnSpheres.hpp"
+#include "EngineStats.hpp"
+#include "Trace.hpp"
+
+#define PI 3.14159265358979323846
+
+void SphereDomain::Set(const glm::vec3& box_min, const glm::vec3& box_max, double target_radius)
+{
+	low = glm::dvec3(box_min);
+	high = glm::dvec3(box_max);
+	target = target_radius;
+	glm::dvec3 half = (high - low) * 0.5;
+	double scale = std::min(half.x, std::min(half.y, half.z));
+	if (target > 0.0)
+		scale = std::min(scale, target);
+	epsilon = SPHERE_EPSILON * scale;
+}
+
+// Uniform on the unit sphere: the height is uniform (Archimedes), the
+// angle around the axis too.
+static glm::dvec3 UnitVector(Rng& rng)
+{
+	double z = 2.0 * rng.Uniform() - 1.0;
+	double angle = 2.0 * PI * rng.Uniform();
+	double r = sqrt(1.0 - z * z);
+	return glm::dvec3(r * cos(angle), r * sin(angle), z);
+}
+
+void SphereTrials(Rng& rng, const SphereDomain& domain, const glm::dvec3& start, int trials,
+	float fractions[SPHERE_BOUNDARIES], float& spheres)
+{
+	TRACE_ZONE("SphereTrials");
+	StatBusy busy;
+	long long hits[SPHERE_BOUNDARIES] = {};
+	long long jumps = 0;
+	for (int i = 0; i < trials; ++i)
+	{
+		glm::dvec3 x = start;
+		int nearest;
+		double d = domain.Distance(x, nearest);
+		while (d > domain.epsilon)
+		{
+			x += d * UnitVector(rng);
+			++jumps;
+			d = domain.Distance(x, nearest);
+		}
+		++hits[nearest];
+		StatAdd(STAT_TRIALS);
+	}
+	StatAdd(STAT_STEPS, jumps);
+
+	for (int b = 0; b < SPHERE_BOUNDARIES; ++b)
+		fractions[b] = (float)hits[b] / trials;
+	spheres = (float)jumps / trials;
+}
@@ -0,0 +1,80 @@
+/* Start Header -------------------------------------------------------
+File Name: WalkOnSpheres.hpp
+Purpose: Walk-on-spheres estimates of exit distributions in a box
+Language: C++
+Platform: MSVC2019 window
+Project: Random Walk Simulation
+Author: Nahye Park
+Creation date: 10/19/2026
+End Header --------------------------------------------------------*/
+#pragma once
+
+#ifndef WALKONSPHERES_HPP
+#define WALKONSPHERES_HPP
+
+#include <math.h>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+#include "Random.hpp"
+
+//x low, x high, y low, y high, z low, z high, then the target ball
+#define SPHERE_BOUNDARIES 7
+#define SPHERE_TARGET 6
+
+//walks stop this close to the boundary, relative to the smallest half-width
+//or the target radius
+#define SPHERE_EPSILON 1e-4
+
+// The inside of a box, minus a ball of radius target around the origin if
+// target > 0. Brownian motion, the continuum limit of the lattice walks,
+// leaves the largest ball around a point inside it at a uniform point of
+// the sphere, so it can jump there in one draw; the walk stops once it is
+// within epsilon of the boundary, with an error of order epsilon.
+struct SphereDomain {
+	glm::dvec3 low;
+	glm::dvec3 high;
+	double target;
+	double epsilon;
+
+	void Set(const glm::vec3& box_min, const glm::vec3& box_max, double target_radius);
+
+	// Distance to the boundary, and which part of it is nearest.
+	double Distance(const glm::dvec3& x, int& nearest) const
+	{
+		double best = x.x - low.x;
+		nearest = 0;
+		for (int a = 0; a < 3; ++a)
+		{
+			double below = x[a] - low[a];
+			double above = high[a] - x[a];
+			if (below < best)
+			{
+				best = below;
+				nearest = 2 * a;
+			}
+			if (above < best)
+			{
+				best = above;
+				nearest = 2 * a + 1;
+			}
+		}
+		if (target > 0.0)
+		{
+			double ball = sqrt(x.x * x.x + x.y * x.y + x.z * x.z) - target;
+			if (ball < best)
+			{
+				best = ball;
+				nearest = SPHERE_TARGET;
+			}
+		}
+		return best;
+	}
+};
+
+// trials walks from start. fractions[b] is the fraction that ended at
+// boundary b, spheres the average number of jumps.
+void SphereTrials(Rng& rng, const SphereDomain& domain, const glm::dvec3& start, int trials,
+	float fractions[SPHERE_BOUNDARIES], float& spheres);
+
+#endif